@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "WorkStealingPool.hpp"
+
+// reads one point set per line ("x1 y1 x2 y2 ..."), and writes the corners of its bounding polygon to the same line of the output
+// the output line is empty if the points do not form a polygon, or if the line is not a valid point set
+namespace BatchHull
+{
+    const size_t BlockSize = 16 << 20;
+    const size_t ChunkSize = 64 << 10;
+
+
+    struct Options
+    {
+        std::string inputFileName;
+        std::string outputFileName;
+        unsigned int threadCount = 0;
+        Geometry::BoundingPolygonAlgorithm algorithm = Geometry::BoundingPolygonAlgorithm::MonotoneChain;
+        bool cullInteriorPoints = false;
+    };
+
+
+    // the output of the lines of one chunk, and the indices of its invalid lines
+    struct ChunkResult
+    {
+        std::string output;
+        size_t lineCount = 0;
+        std::vector<size_t> invalidLineIndices;
+    };
+
+
+    static bool IsSpace (char character)
+    {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+
+    static bool ParsePointSet (const char* lineBegin, const char* lineEnd, Geometry::PointArray& points)
+    {
+        points.clear ();
+        int coords[2];
+        size_t coordCount = 0;
+        const char* position = lineBegin;
+        while (true) {
+            while (position != lineEnd && IsSpace (*position))
+                position++;
+            if (position == lineEnd)
+                return coordCount == 0;
+
+            const std::from_chars_result result = std::from_chars (position, lineEnd, coords[coordCount]);
+            if (result.ec != std::errc () || (result.ptr != lineEnd && !IsSpace (*result.ptr)))
+                return false;
+            position = result.ptr;
+
+            if (++coordCount == 2) {
+                points.emplace_back (coords[0], coords[1]);
+                coordCount = 0;
+            }
+        }
+    }
+
+
+    static void AppendPolygon (const Geometry::Polygon& polygon, std::string& output)
+    {
+        char buffer[32];
+        for (size_t index = 0; index < polygon.size (); index++) {
+            if (index > 0)
+                output += ' ';
+            output.append (buffer, std::to_chars (buffer, buffer + sizeof (buffer), polygon[index].x).ptr);
+            output += ' ';
+            output.append (buffer, std::to_chars (buffer, buffer + sizeof (buffer), polygon[index].y).ptr);
+        }
+        output += '\n';
+    }
+
+
+    // the chunk consists of whole lines, the point buffer is reused for every line
+    // the culling keeps the extreme points, so the remaining points still do not lie in one line
+    static void ProcessChunk (const char* chunkBegin, const char* chunkEnd, const Options& options, ChunkResult& result)
+    {
+        Geometry::PointArray points;
+        for (const char* lineBegin = chunkBegin; lineBegin != chunkEnd; result.lineCount++) {
+            const char* lineEnd = std::find (lineBegin, chunkEnd, '\n');
+            const bool isValidLine = ParsePointSet (lineBegin, lineEnd, points);
+            lineBegin = lineEnd == chunkEnd ? chunkEnd : lineEnd + 1;
+            if (!isValidLine) {
+                result.invalidLineIndices.push_back (result.lineCount);
+                result.output += '\n';
+                continue;
+            }
+
+            Geometry::RemoveDuplicatePoints (points);
+            if (points.size () < 3 || Geometry::AreAllPointsInOneLine (points)) {
+                result.output += '\n';
+                continue;
+            }
+
+            if (options.cullInteriorPoints)
+                points = Geometry::CullInteriorPoints (points).points;
+            const Geometry::Polygon polygon = Geometry::CalculateBoundingPolygon (points, options.algorithm);
+            AppendPolygon (polygon.size () > 2 ? polygon : Geometry::Polygon (), result.output);
+        }
+    }
+
+
+    static bool ParseAlgorithm (const std::string& name, Geometry::BoundingPolygonAlgorithm& algorithm)
+    {
+        if (name == "giftwrapping")
+            algorithm = Geometry::BoundingPolygonAlgorithm::GiftWrapping;
+        else if (name == "monotonechain")
+            algorithm = Geometry::BoundingPolygonAlgorithm::MonotoneChain;
+        else if (name == "chan")
+            algorithm = Geometry::BoundingPolygonAlgorithm::Chan;
+        else if (name == "quickhull")
+            algorithm = Geometry::BoundingPolygonAlgorithm::QuickHull;
+        else
+            return false;
+        return true;
+    }
+
+
+    static bool ParseOptions (int argc, char** argv, Options& options)
+    {
+        std::vector<std::string> fileNames;
+        for (int index = 1; index < argc; index++) {
+            const std::string argument = argv[index];
+            if (argument == "--threads" && index + 1 < argc) {
+                const char* value = argv[++index];
+                if (std::from_chars (value, value + std::strlen (value), options.threadCount).ec != std::errc ())
+                    return false;
+            } else if (argument == "--algorithm" && index + 1 < argc) {
+                if (!ParseAlgorithm (argv[++index], options.algorithm))
+                    return false;
+            } else if (argument == "--cull-interior-points") {
+                options.cullInteriorPoints = true;
+            } else {
+                fileNames.push_back (argument);
+            }
+        }
+        if (fileNames.size () != 2)
+            return false;
+
+        options.inputFileName = fileNames[0];
+        options.outputFileName = fileNames[1];
+        return true;
+    }
+
+
+    // the input is read in blocks of whole lines, every block is split into chunks that are processed in parallel
+    // the outputs of the chunks are written in the order of the input
+    // an invalid line is reported and gets an empty output line, so the output always has a line for every input line
+    static int Run (const Options& options)
+    {
+        std::ifstream inputFile (options.inputFileName, std::ios::binary);
+        if (!inputFile) {
+            std::cerr << "cannot open " << options.inputFileName << std::endl;
+            return 1;
+        }
+        std::ofstream outputFile (options.outputFileName, std::ios::binary | std::ios::trunc);
+        if (!outputFile) {
+            std::cerr << "cannot create " << options.outputFileName << std::endl;
+            return 1;
+        }
+
+        const unsigned int threadCount = options.threadCount > 0 ? options.threadCount : std::max (std::thread::hardware_concurrency (), 1u);
+        Parallel::WorkStealingPool pool (threadCount - 1);
+
+        std::vector<char> block;
+        size_t firstLineNumber = 1;
+        size_t invalidLineCount = 0;
+        while (inputFile || !block.empty ()) {
+            const size_t carriedSize = block.size ();
+            block.resize (BlockSize + carriedSize);
+            inputFile.read (block.data () + carriedSize, BlockSize);
+            block.resize (carriedSize + (size_t) inputFile.gcount ());
+            if (block.empty ())
+                break;
+
+            // the incomplete last line is carried over to the next block, unless the input has ended
+            size_t blockEnd = block.size ();
+            if (inputFile) {
+                const auto lastNewLine = std::find (block.rbegin (), block.rend (), '\n');
+                blockEnd = lastNewLine == block.rend () ? 0 : block.rend () - lastNewLine;
+                if (blockEnd == 0)
+                    continue;
+            }
+
+            std::vector<const char*> chunkBegins = {block.data ()};
+            const char* const blockEndPointer = block.data () + blockEnd;
+            while (chunkBegins.back () != blockEndPointer) {
+                const char* chunkEnd = chunkBegins.back () + std::min<size_t> (ChunkSize, blockEndPointer - chunkBegins.back ());
+                chunkEnd = std::find (chunkEnd, blockEndPointer, '\n');
+                chunkBegins.push_back (chunkEnd == blockEndPointer ? chunkEnd : chunkEnd + 1);
+            }
+
+            std::vector<ChunkResult> chunkResults (chunkBegins.size () - 1);
+            {
+                Parallel::TaskGroup taskGroup (pool);
+                for (size_t chunk = 0; chunk < chunkResults.size (); chunk++) {
+                    taskGroup.Run ([&, chunk] {
+                        ProcessChunk (chunkBegins[chunk], chunkBegins[chunk + 1], options, chunkResults[chunk]);
+                    });
+                }
+            }
+
+            for (const ChunkResult& chunkResult : chunkResults) {
+                for (size_t invalidLineIndex : chunkResult.invalidLineIndices)
+                    std::cerr << options.inputFileName << ":" << firstLineNumber + invalidLineIndex << ": invalid point set" << std::endl;
+                invalidLineCount += chunkResult.invalidLineIndices.size ();
+                outputFile.write (chunkResult.output.data (), chunkResult.output.size ());
+                firstLineNumber += chunkResult.lineCount;
+            }
+
+            block.erase (block.begin (), block.begin () + blockEnd);
+        }
+
+        outputFile.flush ();
+        if (!outputFile) {
+            std::cerr << "cannot write " << options.outputFileName << std::endl;
+            return 1;
+        }
+        return invalidLineCount > 0 ? 1 : 0;
+    }
+}
+
+
+int main (int argc, char** argv)
+{
+    BatchHull::Options options;
+    if (!BatchHull::ParseOptions (argc, argv, options)) {
+        std::cerr << "usage: BatchHull [--threads count] [--algorithm giftwrapping|monotonechain|chan|quickhull] [--cull-interior-points] input output" << std::endl;
+        return 2;
+    }
+    return BatchHull::Run (options);
+}
\ No newline at end of file
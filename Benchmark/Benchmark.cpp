@@ -0,0 +1,500 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined (__linux__) && (defined (__unix__) || defined (__APPLE__))
+#include <sys/resource.h>
+#endif
+
+#include "Geometry.hpp"
+
+// runs the public Geometry functions over generated point distributions, and writes the measurements as JSON
+namespace Benchmark
+{
+    struct Options
+    {
+        std::vector<size_t> sizes = {10, 100, 1000, 10000, 100000, 1000000};
+        std::vector<std::string> distributionNames;
+        std::vector<std::string> entryNames;
+        unsigned int repetitionCount = 3;
+        double timeLimitSeconds = 5.0;
+        size_t maxPointSetSize = 10000000;
+        std::string outputFileName;
+    };
+
+
+    // the points of a distribution are generated with the same seed for every entry
+    struct Distribution
+    {
+        std::string name;
+        std::function<Geometry::PointArray (size_t pointCount, std::mt19937_64& generator)> generatePoints;
+    };
+
+
+    // the input prepared outside of the measured part
+    struct Input
+    {
+        Geometry::PointArray points;
+        Geometry::PointSet pointSet;
+        Geometry::Polygon polygon;
+    };
+
+
+    // runs the function once, and returns the size of the resulting polygon (0 if the function does not calculate one)
+    struct Entry
+    {
+        std::string name;
+        bool usesPointSet;
+        std::function<size_t (const Input& input)> run;
+    };
+
+
+    struct Measurement
+    {
+        std::string entryName;
+        std::string distributionName;
+        size_t pointCount = 0;
+        size_t polygonPointCount = 0;
+        std::vector<double> nanoseconds;
+        long long peakMemoryBytes = -1;
+        bool skipped = false;
+    };
+
+
+    const int CoordRange = 1000000;
+
+
+    static Geometry::PointArray GenerateUniformSquare (size_t pointCount, std::mt19937_64& generator)
+    {
+        std::uniform_int_distribution<int> coordDistribution (-CoordRange, CoordRange);
+        Geometry::PointArray points (pointCount);
+        for (Geometry::Point& point : points)
+            point = Geometry::Point (coordDistribution (generator), coordDistribution (generator));
+        return points;
+    }
+
+
+    static Geometry::PointArray GenerateUniformDisk (size_t pointCount, std::mt19937_64& generator)
+    {
+        std::uniform_int_distribution<int> coordDistribution (-CoordRange, CoordRange);
+        Geometry::PointArray points;
+        points.reserve (pointCount);
+        while (points.size () < pointCount) {
+            const Geometry::Point point (coordDistribution (generator), coordDistribution (generator));
+            if ((long long) point.x * point.x + (long long) point.y * point.y <= (long long) CoordRange * CoordRange)
+                points.push_back (point);
+        }
+        return points;
+    }
+
+
+    // the points are rounded to whole coords, so the polygon has a corner at most of the points
+    static Geometry::PointArray GenerateCircle (size_t pointCount, std::mt19937_64& generator)
+    {
+        std::uniform_real_distribution<double> angleDistribution (0.0, 2.0 * 3.14159265358979323846);
+        Geometry::PointArray points (pointCount);
+        for (Geometry::Point& point : points) {
+            const double angle = angleDistribution (generator);
+            point = Geometry::Point ((int) std::lround (CoordRange * std::cos (angle)), (int) std::lround (CoordRange * std::sin (angle)));
+        }
+        return points;
+    }
+
+
+    static Geometry::PointArray GenerateGaussian (size_t pointCount, std::mt19937_64& generator)
+    {
+        std::normal_distribution<double> coordDistribution (0.0, CoordRange / 10.0);
+        Geometry::PointArray points (pointCount);
+        for (Geometry::Point& point : points) {
+            const double x = std::clamp (coordDistribution (generator), (double) -CoordRange, (double) CoordRange);
+            const double y = std::clamp (coordDistribution (generator), (double) -CoordRange, (double) CoordRange);
+            point = Geometry::Point ((int) std::lround (x), (int) std::lround (y));
+        }
+        return points;
+    }
+
+
+    static Geometry::PointArray GenerateGrid (size_t pointCount, std::mt19937_64&)
+    {
+        const size_t sideLength = std::max<size_t> (2, (size_t) std::ceil (std::sqrt ((double) pointCount)));
+        Geometry::PointArray points (pointCount);
+        for (size_t index = 0; index < pointCount; index++)
+            points[index] = Geometry::Point ((int) (index % sideLength), (int) (index / sideLength));
+        return points;
+    }
+
+
+    // the points are on the sides of a square, so most of them are collinear with the corners
+    static Geometry::PointArray GenerateCollinear (size_t pointCount, std::mt19937_64& generator)
+    {
+        std::uniform_int_distribution<int> coordDistribution (-CoordRange, CoordRange);
+        Geometry::PointArray points (pointCount);
+        for (size_t index = 0; index < pointCount; index++) {
+            const int coord = coordDistribution (generator);
+            switch (index % 4) {
+                case 0: points[index] = Geometry::Point (coord, -CoordRange); break;
+                case 1: points[index] = Geometry::Point (CoordRange, coord); break;
+                case 2: points[index] = Geometry::Point (coord, CoordRange); break;
+                default: points[index] = Geometry::Point (-CoordRange, coord); break;
+            }
+        }
+        return points;
+    }
+
+
+    // at most 101 * 101 different points
+    static Geometry::PointArray GenerateDuplicates (size_t pointCount, std::mt19937_64& generator)
+    {
+        std::uniform_int_distribution<int> coordDistribution (-50, 50);
+        Geometry::PointArray points (pointCount);
+        for (Geometry::Point& point : points)
+            point = Geometry::Point (coordDistribution (generator), coordDistribution (generator));
+        return points;
+    }
+
+
+    static std::vector<Distribution> GetDistributions ()
+    {
+        return {
+            {"uniformSquare", GenerateUniformSquare},
+            {"uniformDisk", GenerateUniformDisk},
+            {"circle", GenerateCircle},
+            {"gaussian", GenerateGaussian},
+            {"grid", GenerateGrid},
+            {"collinear", GenerateCollinear},
+            {"duplicates", GenerateDuplicates}
+        };
+    }
+
+
+    static Entry CreateHullEntry (const std::string& name, Geometry::BoundingPolygonAlgorithm algorithm)
+    {
+        return {name, false, [algorithm] (const Input& input) {
+            return Geometry::CalculateBoundingPolygon (input.points, algorithm).size ();
+        }};
+    }
+
+
+    static Entry CreatePointSetHullEntry (const std::string& name, Geometry::BoundingPolygonAlgorithm algorithm)
+    {
+        return {name, true, [algorithm] (const Input& input) {
+            return Geometry::CalculateBoundingPolygon (input.pointSet, algorithm).size ();
+        }};
+    }
+
+
+    // single threaded, so the time shows the speed of the point location kernel
+    static size_t ClassifyInputPoints (const Input& input)
+    {
+        const Geometry::ConvexPolygonQuery polygonQuery (input.polygon);
+        std::vector<Geometry::PointLocation> locations (input.points.size ());
+        Geometry::ClassifyPoints (polygonQuery, input.points, locations.data ());
+        return input.polygon.size ();
+    }
+
+
+    static std::vector<Entry> GetEntries ()
+    {
+        return {
+            CreateHullEntry ("CalculateBoundingPolygon/GiftWrapping", Geometry::BoundingPolygonAlgorithm::GiftWrapping),
+            CreateHullEntry ("CalculateBoundingPolygon/MonotoneChain", Geometry::BoundingPolygonAlgorithm::MonotoneChain),
+            CreateHullEntry ("CalculateBoundingPolygon/Chan", Geometry::BoundingPolygonAlgorithm::Chan),
+            CreateHullEntry ("CalculateBoundingPolygon/QuickHull", Geometry::BoundingPolygonAlgorithm::QuickHull),
+            CreatePointSetHullEntry ("CalculateBoundingPolygon/GiftWrapping/PointSet", Geometry::BoundingPolygonAlgorithm::GiftWrapping),
+            CreatePointSetHullEntry ("CalculateBoundingPolygon/MonotoneChain/PointSet", Geometry::BoundingPolygonAlgorithm::MonotoneChain),
+            CreatePointSetHullEntry ("CalculateBoundingPolygon/Chan/PointSet", Geometry::BoundingPolygonAlgorithm::Chan),
+            CreatePointSetHullEntry ("CalculateBoundingPolygon/QuickHull/PointSet", Geometry::BoundingPolygonAlgorithm::QuickHull),
+            {"CalculateBoundingPolygonInParallel", true, [] (const Input& input) {
+                return Geometry::CalculateBoundingPolygonInParallel (input.pointSet, 0).size ();
+            }},
+            {"CalculateBoundingPolygonInParallel/Span", false, [] (const Input& input) {
+                return Geometry::CalculateBoundingPolygonInParallel (input.points, 0).size ();
+            }},
+            {"CalculateBoundingPolygonWithQuickHull", false, [] (const Input& input) {
+                return Geometry::CalculateBoundingPolygonWithQuickHull (input.points, 0).size ();
+            }},
+            {"CullInteriorPoints", false, [] (const Input& input) {
+                Geometry::CullInteriorPoints (input.points);
+                return (size_t) 0;
+            }},
+            {"CheckIfPolygonContainsAllPoints", false, [] (const Input& input) {
+                Geometry::CheckIfPolygonContainsAllPoints (input.polygon, input.points);
+                return input.polygon.size ();
+            }},
+            {"CheckIfPolygonContainsAllPoints/PointSet", true, [] (const Input& input) {
+                Geometry::CheckIfPolygonContainsAllPoints (input.polygon, input.pointSet);
+                return input.polygon.size ();
+            }},
+            {"ClassifyPoints", false, ClassifyInputPoints},
+            {"ClassifyPoints/Scalar", false, [] (const Input& input) {
+                Geometry::LimitVectorInstructionSet (Geometry::VectorInstructionSet::None);
+                const size_t polygonPointCount = ClassifyInputPoints (input);
+                Geometry::LimitVectorInstructionSet (Geometry::VectorInstructionSet::AVX2);
+                return polygonPointCount;
+            }},
+            {"FindLeftMostPoint", false, [] (const Input& input) {
+                Geometry::FindLeftMostPoint (input.points);
+                return (size_t) 0;
+            }},
+            {"FindLeftMostPoint/PointSet", true, [] (const Input& input) {
+                Geometry::FindLeftMostPoint (input.pointSet);
+                return (size_t) 0;
+            }},
+            {"AreAllPointsInOneLine", false, [] (const Input& input) {
+                Geometry::AreAllPointsInOneLine (input.points);
+                return (size_t) 0;
+            }},
+            {"AreAllPointsInOneLine/PointSet", true, [] (const Input& input) {
+                Geometry::AreAllPointsInOneLine (input.pointSet);
+                return (size_t) 0;
+            }},
+            {"CalculatePointBounds", false, [] (const Input& input) {
+                Geometry::CalculatePointBounds (input.points.data (), input.points.size ());
+                return (size_t) 0;
+            }},
+            {"CalculatePointBounds/Scalar", false, [] (const Input& input) {
+                Geometry::LimitVectorInstructionSet (Geometry::VectorInstructionSet::None);
+                Geometry::CalculatePointBounds (input.points.data (), input.points.size ());
+                Geometry::LimitVectorInstructionSet (Geometry::VectorInstructionSet::AVX2);
+                return (size_t) 0;
+            }}
+        };
+    }
+
+
+    // on Linux the peak resident set size can be reset, so it is measured for every case separately
+    // on other Unix systems the peak of the whole process is reported, elsewhere it is not measured
+    static void ResetPeakMemory ()
+    {
+#if defined (__linux__)
+        std::ofstream clearRefsFile ("/proc/self/clear_refs");
+        clearRefsFile << "5";
+#endif
+    }
+
+
+    static long long GetPeakMemoryBytes ()
+    {
+#if defined (__linux__)
+        std::ifstream statusFile ("/proc/self/status");
+        std::string line;
+        while (std::getline (statusFile, line)) {
+            if (line.compare (0, 6, "VmHWM:") == 0)
+                return std::stoll (line.substr (6)) * 1024;
+        }
+        return -1;
+#elif defined (__unix__) || defined (__APPLE__)
+        rusage usage;
+        getrusage (RUSAGE_SELF, &usage);
+#if defined (__APPLE__)
+        return usage.ru_maxrss;
+#else
+        return usage.ru_maxrss * 1024LL;
+#endif
+#else
+        return -1;
+#endif
+    }
+
+
+    static bool IsSelected (const std::vector<std::string>& selectedNames, const std::string& name)
+    {
+        return selectedNames.empty () || std::find (selectedNames.begin (), selectedNames.end (), name) != selectedNames.end ();
+    }
+
+
+    // the entries need a valid polygon, so the point sets in one line are extended by a point outside of the line
+    static Input PrepareInput (const Distribution& distribution, size_t pointCount, bool needsPointSet)
+    {
+        std::mt19937_64 generator (pointCount);
+        Input input;
+        input.points = distribution.generatePoints (pointCount, generator);
+        if (input.points.size () < 3 || Geometry::AreAllPointsInOneLine (input.points)) {
+            input.points.push_back (Geometry::Point (-CoordRange, CoordRange));
+            input.points.push_back (Geometry::Point (CoordRange, -CoordRange));
+        }
+        if (needsPointSet)
+            input.pointSet = Geometry::PointSet (input.points.begin (), input.points.end ());
+        input.polygon = Geometry::CalculateBoundingPolygon (input.points, Geometry::BoundingPolygonAlgorithm::MonotoneChain);
+        return input;
+    }
+
+
+    // the time of a run is estimated from the time per point of the previous size of the same entry and distribution
+    // the run is skipped if the estimate is above the time limit, the real time can only be longer for the superlinear functions
+    static std::vector<Measurement> RunBenchmarks (const Options& options)
+    {
+        std::vector<Measurement> measurements;
+        const std::vector<Entry> entries = GetEntries ();
+        for (const Distribution& distribution : GetDistributions ()) {
+            if (!IsSelected (options.distributionNames, distribution.name))
+                continue;
+
+            std::vector<double> nanosecondsPerPoint (entries.size (), 0.0);
+            for (size_t pointCount : options.sizes) {
+                bool needsPointSet = false;
+                for (const Entry& entry : entries)
+                    needsPointSet = needsPointSet || (entry.usesPointSet && IsSelected (options.entryNames, entry.name));
+                const Input input = PrepareInput (distribution, pointCount, needsPointSet && pointCount <= options.maxPointSetSize);
+
+                for (size_t entryIndex = 0; entryIndex < entries.size (); entryIndex++) {
+                    const Entry& entry = entries[entryIndex];
+                    if (!IsSelected (options.entryNames, entry.name))
+                        continue;
+
+                    Measurement measurement;
+                    measurement.entryName = entry.name;
+                    measurement.distributionName = distribution.name;
+                    measurement.pointCount = input.points.size ();
+                    measurement.skipped = nanosecondsPerPoint[entryIndex] * measurement.pointCount > options.timeLimitSeconds * 1e9 ||
+                                          (entry.usesPointSet && pointCount > options.maxPointSetSize);
+                    if (!measurement.skipped) {
+                        ResetPeakMemory ();
+                        for (unsigned int repetition = 0; repetition < options.repetitionCount; repetition++) {
+                            const auto start = std::chrono::steady_clock::now ();
+                            measurement.polygonPointCount = entry.run (input);
+                            const auto stop = std::chrono::steady_clock::now ();
+                            measurement.nanoseconds.push_back (std::chrono::duration<double, std::nano> (stop - start).count ());
+                            if (measurement.nanoseconds.back () > options.timeLimitSeconds * 1e9)
+                                break;
+                        }
+                        measurement.peakMemoryBytes = GetPeakMemoryBytes ();
+                        nanosecondsPerPoint[entryIndex] = *std::min_element (measurement.nanoseconds.begin (), measurement.nanoseconds.end ()) / measurement.pointCount;
+                    }
+
+                    std::cerr << entry.name << " " << distribution.name << " " << measurement.pointCount << (measurement.skipped ? " skipped" : "") << std::endl;
+                    measurements.push_back (measurement);
+                }
+            }
+        }
+        return measurements;
+    }
+
+
+    static void WriteMeasurement (std::ostream& output, const Measurement& measurement)
+    {
+        output << "    {\"entry\": \"" << measurement.entryName << "\", \"distribution\": \"" << measurement.distributionName
+               << "\", \"pointCount\": " << measurement.pointCount;
+        if (measurement.skipped) {
+            output << ", \"skipped\": true}";
+            return;
+        }
+
+        std::vector<double> sortedNanoseconds = measurement.nanoseconds;
+        std::sort (sortedNanoseconds.begin (), sortedNanoseconds.end ());
+        const double bestNanoseconds = sortedNanoseconds.front ();
+        const double medianNanoseconds = sortedNanoseconds[sortedNanoseconds.size () / 2];
+        output << ", \"polygonPointCount\": " << measurement.polygonPointCount
+               << ", \"repetitions\": " << measurement.nanoseconds.size ()
+               << ", \"bestNanoseconds\": " << bestNanoseconds
+               << ", \"medianNanoseconds\": " << medianNanoseconds
+               << ", \"nanosecondsPerPoint\": " << bestNanoseconds / measurement.pointCount
+               << ", \"pointsPerSecond\": " << measurement.pointCount / (bestNanoseconds * 1e-9);
+        if (measurement.peakMemoryBytes >= 0)
+            output << ", \"peakMemoryBytes\": " << measurement.peakMemoryBytes;
+        else
+            output << ", \"peakMemoryBytes\": null";
+        output << "}";
+    }
+
+
+    static const char* GetInstructionSetName (Geometry::VectorInstructionSet instructionSet)
+    {
+        switch (instructionSet) {
+            case Geometry::VectorInstructionSet::AVX2:
+                return "avx2";
+            case Geometry::VectorInstructionSet::SSE41:
+                return "sse4.1";
+            default:
+                return "none";
+        }
+    }
+
+
+    // the instruction set shows which kernels were used by the entries that are not limited to the scalar code
+    static void WriteMeasurements (std::ostream& output, const std::vector<Measurement>& measurements)
+    {
+        output.precision (10);
+        output << "{\n  \"hardwareThreads\": " << std::thread::hardware_concurrency ()
+               << ",\n  \"vectorInstructionSet\": \"" << GetInstructionSetName (Geometry::GetVectorInstructionSet ())
+               << "\",\n  \"results\": [\n";
+        for (size_t index = 0; index < measurements.size (); index++) {
+            WriteMeasurement (output, measurements[index]);
+            output << (index + 1 < measurements.size () ? ",\n" : "\n");
+        }
+        output << "  ]\n}\n";
+    }
+
+
+    static std::vector<std::string> SplitList (const std::string& list)
+    {
+        std::vector<std::string> items;
+        std::stringstream stream (list);
+        std::string item;
+        while (std::getline (stream, item, ','))
+            items.push_back (item);
+        return items;
+    }
+
+
+    static bool ParseOptions (int argc, char** argv, Options& options)
+    {
+        try {
+            for (int index = 1; index + 1 < argc; index += 2) {
+                const std::string argument = argv[index];
+                const std::string value = argv[index + 1];
+                if (argument == "--sizes") {
+                    options.sizes.clear ();
+                    for (const std::string& size : SplitList (value))
+                        options.sizes.push_back ((size_t) std::stod (size));
+                } else if (argument == "--distributions") {
+                    options.distributionNames = SplitList (value);
+                } else if (argument == "--entries") {
+                    options.entryNames = SplitList (value);
+                } else if (argument == "--repetitions") {
+                    options.repetitionCount = std::max (std::stoi (value), 1);
+                } else if (argument == "--time-limit") {
+                    options.timeLimitSeconds = std::stod (value);
+                } else if (argument == "--max-point-set-size") {
+                    options.maxPointSetSize = (size_t) std::stod (value);
+                } else if (argument == "--output") {
+                    options.outputFileName = value;
+                } else {
+                    return false;
+                }
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+        return argc % 2 == 1;
+    }
+}
+
+
+int main (int argc, char** argv)
+{
+    Benchmark::Options options;
+    if (!Benchmark::ParseOptions (argc, argv, options)) {
+        std::cerr << "usage: Benchmark [--sizes 10,1e3,...] [--distributions name,...] [--entries name,...] [--repetitions count]"
+                  << " [--time-limit seconds] [--max-point-set-size count] [--output file]" << std::endl;
+        return 2;
+    }
+
+    const std::vector<Benchmark::Measurement> measurements = Benchmark::RunBenchmarks (options);
+    if (options.outputFileName.empty ()) {
+        Benchmark::WriteMeasurements (std::cout, measurements);
+        return 0;
+    }
+
+    std::ofstream outputFile (options.outputFileName);
+    Benchmark::WriteMeasurements (outputFile, measurements);
+    return outputFile ? 0 : 1;
+}
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace UI
     public:
         virtual void SetClearCanvasButtonState (bool newState) = 0;
         virtual void SetDrawPolygonButtonState (bool newState) = 0;
+        virtual void PolygonOutdated () = 0;
         virtual ~ButtonStateNotifier ();
     };
 }
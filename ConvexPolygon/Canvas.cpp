@@ -1,84 +1,386 @@
 #include "Canvas.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include "wx/dcbuffer.h"
+
 #include "ButtonStateNotifier.hpp"
 #include "Logic.hpp"
 
 namespace UI
 {
+    const wxColor PointColor (0, 0, 0);
     const wxColor PolygonColor (0, 102, 153);
     const wxColor InvalidPolygonColor (255, 204, 153);
 
+    const double MinViewScale = 1.0 / 1024;
+    const double MaxViewScale = 64;
+    const double ZoomStep = 1.25;
+
     BEGIN_EVENT_TABLE (Canvas, wxPanel)
 
         EVT_LEFT_UP (Canvas::MouseReleased)
+        EVT_RIGHT_UP (Canvas::RightMouseReleased)
+        EVT_MIDDLE_DOWN (Canvas::MiddleMousePressed)
+        EVT_MOTION (Canvas::MouseMoved)
+        EVT_MOUSEWHEEL (Canvas::MouseWheelRotated)
 
         EVT_PAINT (Canvas::PaintEvent)
 
         END_EVENT_TABLE ()
 
 
+    ViewTransform::ViewTransform () :
+        scale (1),
+        originX (0),
+        originY (0)
+    {}
+
+
+    double ViewTransform::GetScale () const
+    {
+        return scale;
+    }
+
+
+    wxPoint ViewTransform::ToScreen (const wxPoint& point) const
+    {
+        return wxPoint ((int) std::floor ((point.x - originX) * scale), (int) std::floor ((point.y - originY) * scale));
+    }
+
+
+    wxPoint ViewTransform::ToData (const wxPoint& screenPoint) const
+    {
+        const wxRealPoint dataPoint = ToExactData (screenPoint);
+        return wxPoint ((int) std::floor (dataPoint.x), (int) std::floor (dataPoint.y));
+    }
+
+
+    wxRealPoint ViewTransform::ToExactData (const wxPoint& screenPoint) const
+    {
+        return wxRealPoint (screenPoint.x / scale + originX, screenPoint.y / scale + originY);
+    }
+
+
+    // the data rectangle contains every point that is mapped to a pixel of the screen rectangle
+    wxRect ViewTransform::ToDataRect (const wxRect& screenRect) const
+    {
+        return wxRect (ToData (screenRect.GetTopLeft ()), ToData (wxPoint (screenRect.GetRight () + 1, screenRect.GetBottom () + 1)));
+    }
+
+
+    void ViewTransform::Pan (const wxPoint& screenOffset)
+    {
+        originX -= screenOffset.x / scale;
+        originY -= screenOffset.y / scale;
+    }
+
+
+    // the data coordinate under the anchor stays at the same pixel
+    void ViewTransform::Zoom (double factor, const wxPoint& screenAnchor)
+    {
+        const double anchorX = screenAnchor.x / scale + originX;
+        const double anchorY = screenAnchor.y / scale + originY;
+        scale = std::min (std::max (scale * factor, MinViewScale), MaxViewScale);
+        originX = anchorX - screenAnchor.x / scale;
+        originY = anchorY - screenAnchor.y / scale;
+    }
+
+
     Canvas::Canvas (wxFrame* parent, const wxPoint& position, const wxSize& size, ButtonStateNotifier& buttonStateNotifier) :
         wxPanel (parent, -1, position, size),
         data (*this),
-        buttonStateNotifier (buttonStateNotifier)
+        buttonStateNotifier (buttonStateNotifier),
+        isPointLayerUpToDate (false),
+        isDensityMode (false),
+        visiblePointCount (0),
+        isDrawnPolygonUpToDate (true)
     {
+        // every pixel is drawn by Render, so the background does not have to be erased
+        SetBackgroundStyle (wxBG_STYLE_PAINT);
     }
 
 
+    const int PointMarkerSize = 6;
+    const int LineWidth = 2;
+
+    // above this many points per pixel the color of the density layer does not change
+    const double DensitySaturation = 256;
+
+
+    // the rectangles contain every pixel of the marker or the edge, including the width of the pen
+    static wxRect GetMarkerRect (const wxPoint& screenPoint)
+    {
+        const int halfXSize = PointMarkerSize / 2;
+        return wxRect (screenPoint.x - halfXSize, screenPoint.y - halfXSize, PointMarkerSize + 1, PointMarkerSize + 1).Inflate (LineWidth);
+    }
+
+
+    static wxRect GetEdgeRect (const wxPoint& point1, const wxPoint& point2)
+    {
+        return wxRect (point1, point2).Inflate (LineWidth);
+    }
+
+
+    static wxRect GetPolygonRect (const Model::UIPolygon& screenPolygon)
+    {
+        wxRect polygonRect;
+        for (size_t index = 0; index + 1 < screenPolygon.size (); index++)
+            polygonRect.Union (GetEdgeRect (screenPolygon[index], screenPolygon[index + 1]));
+        return polygonRect;
+    }
+
+
+    // heatmap colors on a logarithmic scale: white for empty pixels, then from yellow through red to dark purple
+    static void GetDensityColor (unsigned int pointCount, unsigned char* rgb)
+    {
+        if (pointCount == 0) {
+            rgb[0] = rgb[1] = rgb[2] = 255;
+            return;
+        }
+
+        const unsigned char colorStops[3][3] = {{255, 220, 90}, {220, 40, 30}, {60, 0, 50}};
+        const double position = std::min (std::log2 (1.0 + pointCount) / std::log2 (1.0 + DensitySaturation), 1.0) * 2;
+        const int stop = std::min ((int) position, 1);
+        const double weight = position - stop;
+        for (int channel = 0; channel < 3; channel++)
+            rgb[channel] = (unsigned char) (colorStops[stop][channel] + (colorStops[stop + 1][channel] - colorStops[stop][channel]) * weight);
+    }
+
+
+    // the frame is composed in a buffer and copied to the window at once, so it does not flicker
     void Canvas::PaintEvent (wxPaintEvent& evt)
     {
-        wxPaintDC dc (this);
-        Render (dc);
+        wxAutoBufferedPaintDC dc (this);
+        Render (dc, GetUpdateRegion ());
     }
 
 
-    void Canvas::PaintNow ()
+    // only the invalidated parts of the canvas are painted, the rest of the window keeps its content
+    void Canvas::RefreshCanvasRect (const wxRect& rect)
     {
-        wxClientDC dc (this);
-        dc.Clear ();
-        Render (dc);
+        if (!rect.IsEmpty ())
+            RefreshRect (rect, false);
     }
 
 
-    void Canvas::Render (wxDC& dc)
+    // the polygon changes its color if it becomes outdated
+    void Canvas::RefreshPolygonIfOutdated ()
     {
-        DrawPoints (dc);
-        DrawPolygon (dc);
+        if (data.IsPolygonUpToDate () == isDrawnPolygonUpToDate)
+            return;
+        isDrawnPolygonUpToDate = data.IsPolygonUpToDate ();
+        RefreshCanvasRect (drawnPolygonRect);
+    }
+
+
+    // after panning or zooming every pixel changes, so the layers are rebuilt and the whole canvas is painted again
+    void Canvas::ViewChanged ()
+    {
+        isPointLayerUpToDate = false;
+        drawnPolygonRect = GetPolygonRect (GetScreenPolygon ());
+        Refresh (false);
     }
 
 
-    void Canvas::DrawPoints (wxDC& dc)
+    // the updated parts are copied from the cached point layer, and only the polygon edges crossing them are drawn again
+    void Canvas::Render (wxDC& dc, const wxRegion& updateRegion)
     {
-        const int xSize = 6;
-        const int halfXSize = xSize / 2;
-        dc.SetPen (wxPen (wxColor (0, 0, 0), 2));
-        for (const wxPoint& point : data.GetPoints ()) {
-            dc.DrawLine (point.x - halfXSize, point.y - halfXSize, point.x + halfXSize, point.y + halfXSize);
-            dc.DrawLine (point.x - halfXSize, point.y + halfXSize, point.x + halfXSize, point.y - halfXSize);
+        UpdatePointLayer ();
+        wxMemoryDC layerDC;
+        layerDC.SelectObjectAsSource (pointLayer);
+        for (wxRegionIterator regionIterator (updateRegion); regionIterator; ++regionIterator) {
+            const wxRect rect = regionIterator.GetRect ();
+            dc.Blit (rect.x, rect.y, rect.width, rect.height, &layerDC, rect.x, rect.y);
+        }
+        DrawPolygon (dc, updateRegion.GetBox ());
+    }
+
+
+    // the density layer is used if the markers of the visible points would cover the canvas
+    // the limits are different in the two directions, so the canvas does not switch back and forth around the limit
+    bool Canvas::ShouldUseDensityMode () const
+    {
+        const size_t markerArea = (PointMarkerSize + 1) * (PointMarkerSize + 1);
+        if (isDensityMode)
+            return visiblePointCount * markerArea * 2 > pointDensity.size ();
+        return visiblePointCount * markerArea > pointDensity.size ();
+    }
+
+
+    // the point layer is only redrawn from scratch if it was cleared, or the view or the size of the canvas has changed
+    // the visible points are always counted per pixel, so the layer can switch to the density view at any time
+    void Canvas::UpdatePointLayer ()
+    {
+        const wxSize size = GetClientSize ();
+        if (isPointLayerUpToDate && pointLayer.IsOk () && pointLayer.GetWidth () == size.GetWidth () && pointLayer.GetHeight () == size.GetHeight ())
+            return;
+
+        const int width = std::max (size.GetWidth (), 1);
+        const int height = std::max (size.GetHeight (), 1);
+        pointDensity.assign ((size_t) width * height, 0);
+        visiblePointCount = 0;
+        data.FindPointsInRect (view.ToDataRect (wxRect (0, 0, width, height)), pointsInRect);
+        for (const wxPoint& point : pointsInRect) {
+            const wxPoint screenPoint = view.ToScreen (point);
+            if (screenPoint.x >= 0 && screenPoint.x < width && screenPoint.y >= 0 && screenPoint.y < height) {
+                pointDensity[(size_t) screenPoint.y * width + screenPoint.x]++;
+                visiblePointCount++;
+            }
+        }
+
+        isDensityMode = ShouldUseDensityMode ();
+        if (isDensityMode) {
+            DrawDensity (width, height);
+        } else {
+            pointLayer.Create (width, height);
+            wxMemoryDC dc (pointLayer);
+            dc.SetBackground (*wxWHITE_BRUSH);
+            dc.Clear ();
+            DrawPoints (dc, wxRect (0, 0, width, height));
         }
+        isPointLayerUpToDate = true;
     }
 
 
-    void Canvas::DrawPolygon (wxDC& dc)
+    // erases the rectangle on the point layer, and draws the markers that overlap it again
+    void Canvas::UpdatePointLayerRect (const wxRect& rect)
     {
+        wxMemoryDC dc (pointLayer);
+        dc.SetClippingRegion (rect);
+        dc.SetPen (*wxTRANSPARENT_PEN);
+        dc.SetBrush (*wxWHITE_BRUSH);
+        dc.DrawRectangle (rect);
+        DrawPoints (dc, rect);
+    }
+
 
-        const Model::UIPolygon polygon = data.GetPolygonPoints ();
-        if (polygon.size () < 2)
+    // counts the added or removed point at its pixel, and recolors the pixel on the density layer
+    // points outside of the canvas are not counted
+    void Canvas::UpdatePointDensity (const wxPoint& screenPoint, int pointCountChange)
+    {
+        const int width = pointLayer.GetWidth ();
+        if (screenPoint.x < 0 || screenPoint.x >= width || screenPoint.y < 0 || screenPoint.y >= pointLayer.GetHeight ())
             return;
 
-        dc.SetPen (wxPen (data.IsPolygonUpToDate () ? PolygonColor : InvalidPolygonColor, 2));
+        unsigned int& pointCount = pointDensity[(size_t) screenPoint.y * width + screenPoint.x];
+        pointCount += pointCountChange;
+        visiblePointCount += pointCountChange;
+        if (isDensityMode) {
+            unsigned char rgb[3];
+            GetDensityColor (pointCount, rgb);
+            wxMemoryDC dc (pointLayer);
+            dc.SetPen (wxPen (wxColor (rgb[0], rgb[1], rgb[2]), 1));
+            dc.DrawPoint (screenPoint.x, screenPoint.y);
+        }
+    }
+
+
+    void Canvas::DrawPoint (wxDC& dc, const wxPoint& screenPoint)
+    {
+        const int halfXSize = PointMarkerSize / 2;
+        dc.DrawLine (screenPoint.x - halfXSize, screenPoint.y - halfXSize, screenPoint.x + halfXSize, screenPoint.y + halfXSize);
+        dc.DrawLine (screenPoint.x - halfXSize, screenPoint.y + halfXSize, screenPoint.x + halfXSize, screenPoint.y - halfXSize);
+    }
+
+
+    // only the points whose markers may overlap the rectangle are queried
+    void Canvas::DrawPoints (wxDC& dc, const wxRect& updateRect)
+    {
+        const int markerExtent = PointMarkerSize / 2 + LineWidth;
+        data.FindPointsInRect (view.ToDataRect (wxRect (updateRect).Inflate (markerExtent)), pointsInRect);
+        dc.SetPen (wxPen (PointColor, LineWidth));
+        for (const wxPoint& point : pointsInRect) {
+            const wxPoint screenPoint = view.ToScreen (point);
+            if (GetMarkerRect (screenPoint).Intersects (updateRect))
+                DrawPoint (dc, screenPoint);
+        }
+    }
+
+
+    // every pixel of the layer is colored by the number of points in it, this does not depend on the number of points
+    void Canvas::DrawDensity (int width, int height)
+    {
+        wxImage densityImage (width, height, false);
+        unsigned char* pixel = densityImage.GetData ();
+        for (size_t index = 0; index < pointDensity.size (); index++, pixel += 3)
+            GetDensityColor (pointDensity[index], pixel);
+        pointLayer = wxBitmap (densityImage);
+    }
+
+
+    Model::UIPolygon Canvas::GetScreenPolygon () const
+    {
+        Model::UIPolygon screenPolygon;
+        for (const wxPoint& point : data.GetPolygonPoints ())
+            screenPolygon.push_back (view.ToScreen (point));
+        return screenPolygon;
+    }
+
+
+    // consecutive edges that cross the updated rectangle are drawn with one call, the pen is only set once
+    void Canvas::DrawPolygon (wxDC& dc, const wxRect& updateRect)
+    {
+        if (data.GetPolygonPoints ().size () < 2 || !drawnPolygonRect.Intersects (updateRect))
+            return;
 
-        for (int index = 0; index < polygon.size () - 1; index++) {
-            const wxPoint& point1 = polygon[index];
-            const wxPoint& point2 = polygon[index + 1];
-            dc.DrawLine (point1.x, point1.y, point2.x, point2.y);
+        const Model::UIPolygon polygon = GetScreenPolygon ();
+        dc.SetPen (wxPen (data.IsPolygonUpToDate () ? PolygonColor : InvalidPolygonColor, LineWidth));
+        size_t firstIndex = 0;
+        for (size_t index = 0; index + 1 < polygon.size (); index++) {
+            if (GetEdgeRect (polygon[index], polygon[index + 1]).Intersects (updateRect))
+                continue;
+            if (index > firstIndex)
+                dc.DrawLines ((int) (index - firstIndex + 1), &polygon[firstIndex]);
+            firstIndex = index + 1;
         }
+        if (polygon.size () - 1 > firstIndex)
+            dc.DrawLines ((int) (polygon.size () - firstIndex), &polygon[firstIndex]);
     }
 
 
     void Canvas::MouseReleased (wxMouseEvent& event)
     {
-        data.AddPoint (event.GetPosition ());
+        data.AddPoint (view.ToData (event.GetPosition ()));
+    }
+
+
+    // removes the point closest to the cursor, if the cursor is on its marker
+    void Canvas::RightMouseReleased (wxMouseEvent& event)
+    {
+        const double pickRadius = (PointMarkerSize / 2) / view.GetScale ();
+        wxPoint pointToRemove;
+        if (data.FindNearestPoint (view.ToExactData (event.GetPosition ()), pickRadius, pointToRemove))
+            data.RemovePoint (pointToRemove);
+    }
+
+
+    void Canvas::MiddleMousePressed (wxMouseEvent& event)
+    {
+        lastPanPosition = event.GetPosition ();
+    }
+
+
+    // the canvas is panned by dragging with the middle button
+    void Canvas::MouseMoved (wxMouseEvent& event)
+    {
+        if (!event.Dragging () || !event.MiddleIsDown ())
+            return;
+
+        const wxPoint position = event.GetPosition ();
+        view.Pan (wxPoint (position.x - lastPanPosition.x, position.y - lastPanPosition.y));
+        lastPanPosition = position;
+        ViewChanged ();
+    }
+
+
+    // the canvas is zoomed around the cursor
+    void Canvas::MouseWheelRotated (wxMouseEvent& event)
+    {
+        const double oldScale = view.GetScale ();
+        view.Zoom (std::pow (ZoomStep, (double) event.GetWheelRotation () / event.GetWheelDelta ()), event.GetPosition ());
+        if (view.GetScale () != oldScale)
+            ViewChanged ();
     }
 
 
@@ -94,32 +396,104 @@ namespace UI
     }
 
 
+    const Model::PointSetSummary& Canvas::GetPointSetSummary () const
+    {
+        return data.GetSummary ();
+    }
+
+
+    const Geometry::DynamicBoundingPolygon& Canvas::GetCurrentBoundingPolygon () const
+    {
+        return data.GetBoundingPolygon ();
+    }
+
+
+    bool Canvas::IsPolygonUpToDate () const
+    {
+        return data.IsPolygonUpToDate ();
+    }
+
+
+    unsigned long long Canvas::GetPointSetVersion () const
+    {
+        return data.GetPointSetVersion ();
+    }
+
+
     void Canvas::DrawNewPolygon (const Model::UIPolygon& newPolygonPoints)
     {
         data.UpdatePolygon (newPolygonPoints);
     }
 
 
-    void Canvas::PointAdded ()
+    // the new point is drawn onto the cached point layer, and only its marker is painted again
+    // if the canvas becomes too dense for the markers, the layer is rebuilt as a density layer
+    void Canvas::PointAdded (const wxPoint& newPoint)
     {
+        const wxPoint screenPoint = view.ToScreen (newPoint);
+        if (isPointLayerUpToDate) {
+            UpdatePointDensity (screenPoint, 1);
+            if (!isDensityMode && ShouldUseDensityMode ()) {
+                isPointLayerUpToDate = false;
+                Refresh (false);
+            } else if (!isDensityMode) {
+                wxMemoryDC dc (pointLayer);
+                dc.SetPen (wxPen (PointColor, LineWidth));
+                DrawPoint (dc, screenPoint);
+            }
+        }
         buttonStateNotifier.SetClearCanvasButtonState (true);
-        if (!Geometry::AreAllPointsInOneLine (Logic::ConvertUIPointsToLogicalPoints (data.GetPoints ()))) {
+        if (!data.AreAllPointsInOneLine ()) {
             buttonStateNotifier.SetDrawPolygonButtonState (true);
         }
-        PaintNow ();
+        RefreshCanvasRect (GetMarkerRect (screenPoint));
+        RefreshPolygonIfOutdated ();
+        if (!data.IsPolygonUpToDate ())
+            buttonStateNotifier.PolygonOutdated ();
     }
-    
-    
+
+
+    // the marker of the removed point may overlap other markers, so they are drawn again in its rectangle
+    // if the canvas becomes sparse enough for the markers, the layer is rebuilt with markers
+    void Canvas::PointRemoved (const wxPoint& removedPoint)
+    {
+        const wxPoint screenPoint = view.ToScreen (removedPoint);
+        const wxRect markerRect = GetMarkerRect (screenPoint);
+        if (isPointLayerUpToDate) {
+            UpdatePointDensity (screenPoint, -1);
+            if (isDensityMode && !ShouldUseDensityMode ()) {
+                isPointLayerUpToDate = false;
+                Refresh (false);
+            } else if (!isDensityMode) {
+                UpdatePointLayerRect (markerRect);
+            }
+        }
+        buttonStateNotifier.SetClearCanvasButtonState (data.GetSummary ().GetPointCount () > 0);
+        buttonStateNotifier.SetDrawPolygonButtonState (!data.AreAllPointsInOneLine ());
+        RefreshCanvasRect (markerRect);
+        RefreshPolygonIfOutdated ();
+        if (!data.IsPolygonUpToDate ())
+            buttonStateNotifier.PolygonOutdated ();
+    }
+
+
     void Canvas::CanvasCleared ()
     {
+        isPointLayerUpToDate = false;
+        drawnPolygonRect = wxRect ();
+        isDrawnPolygonUpToDate = data.IsPolygonUpToDate ();
         buttonStateNotifier.SetClearCanvasButtonState (false);
         buttonStateNotifier.SetDrawPolygonButtonState (false);
-        PaintNow ();
+        Refresh (false);
     }
-    
-    
+
+
+    // both the old and the new polygon are painted again
     void Canvas::PolygonUpdated ()
     {
-        PaintNow ();
+        const wxRect oldPolygonRect = drawnPolygonRect;
+        drawnPolygonRect = GetPolygonRect (GetScreenPolygon ());
+        isDrawnPolygonUpToDate = data.IsPolygonUpToDate ();
+        RefreshCanvasRect (wxRect (oldPolygonRect).Union (drawnPolygonRect));
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define CANVAS_HPP
 
 #include <unordered_set>
+#include <vector>
 #include "wx/wx.h"
 
 #include "Geometry.hpp"
@@ -11,25 +12,71 @@ namespace UI
 {
     class ButtonStateNotifier;
 
+    // maps the coordinates of the canvas data to the pixels of the canvas
+    // the origin is the data coordinate of the top-left pixel, the scale is the number of pixels per data unit
+    class ViewTransform
+    {
+        double scale;
+        double originX;
+        double originY;
+    public:
+        ViewTransform ();
+        double GetScale () const;
+        wxPoint ToScreen (const wxPoint& point) const;
+        wxPoint ToData (const wxPoint& screenPoint) const;
+        wxRealPoint ToExactData (const wxPoint& screenPoint) const;
+        wxRect ToDataRect (const wxRect& screenRect) const;
+        void Pan (const wxPoint& screenOffset);
+        void Zoom (double factor, const wxPoint& screenAnchor);
+    };
+
     class Canvas : public wxPanel, public Model::CanvasDataUpdater
     {
         Model::CanvasData data;
         ButtonStateNotifier& buttonStateNotifier;
+        ViewTransform view;
+        wxPoint lastPanPosition;
+        std::vector<wxPoint> pointsInRect;
+        wxBitmap pointLayer;
+        bool isPointLayerUpToDate;
+        bool isDensityMode;
+        std::vector<unsigned int> pointDensity;
+        size_t visiblePointCount;
+        wxRect drawnPolygonRect;
+        bool isDrawnPolygonUpToDate;
 
-        void PaintNow ();
-        void Render (wxDC& dc);
-        void DrawPoints (wxDC& dc);
-        void DrawPolygon (wxDC& dc);
+        void RefreshCanvasRect (const wxRect& rect);
+        void RefreshPolygonIfOutdated ();
+        void ViewChanged ();
+        void Render (wxDC& dc, const wxRegion& updateRegion);
+        bool ShouldUseDensityMode () const;
+        void UpdatePointLayer ();
+        void UpdatePointLayerRect (const wxRect& rect);
+        void UpdatePointDensity (const wxPoint& screenPoint, int pointCountChange);
+        void DrawPoint (wxDC& dc, const wxPoint& screenPoint);
+        void DrawPoints (wxDC& dc, const wxRect& updateRect);
+        void DrawDensity (int width, int height);
+        Model::UIPolygon GetScreenPolygon () const;
+        void DrawPolygon (wxDC& dc, const wxRect& updateRect);
     public:
         Canvas (wxFrame* parent, const wxPoint& position, const wxSize& size, ButtonStateNotifier& buttonStateNotifier);
 
         void PaintEvent (wxPaintEvent& evt);
         void MouseReleased (wxMouseEvent& event);
+        void RightMouseReleased (wxMouseEvent& event);
+        void MiddleMousePressed (wxMouseEvent& event);
+        void MouseMoved (wxMouseEvent& event);
+        void MouseWheelRotated (wxMouseEvent& event);
         void ClearPoints ();
         const Model::UIPointSet& GetCurrentPointSet () const;
+        const Model::PointSetSummary& GetPointSetSummary () const;
+        const Geometry::DynamicBoundingPolygon& GetCurrentBoundingPolygon () const;
+        bool IsPolygonUpToDate () const;
+        unsigned long long GetPointSetVersion () const;
         void DrawNewPolygon (const Model::UIPolygon& newPolygonPoints);
 
-        virtual void PointAdded () override;
+        virtual void PointAdded (const wxPoint& newPoint) override;
+        virtual void PointRemoved (const wxPoint& removedPoint) override;
         virtual void CanvasCleared () override;
         virtual void PolygonUpdated () override;
 
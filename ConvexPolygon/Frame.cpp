@@ -1,7 +1,8 @@
 #include "Frame.hpp"
 
+#include <sstream>
+
 #include "Canvas.hpp"
-#include "Logic.hpp"
 #include "Resources.hpp"
 
 namespace UI
@@ -15,19 +16,37 @@ namespace UI
     const wxPoint ClearButtonPosition {400, 10};
     const wxSize ClearButtonSize {150, 25};
 
+    const wxPoint LivePolygonCheckBoxPosition {150, 10};
+    const wxSize LivePolygonCheckBoxSize {150, 25};
+
     const wxPoint DrawButtonPosition {650, 10};
     const wxSize DrawButtonSize {150, 25};
 
+    const wxPoint StatisticsButtonPosition {900, 10};
+    const wxSize StatisticsButtonSize {150, 25};
+
+    // the changes within one frame are collected into one calculation
+    const int LiveUpdateInterval = 16;
+
 
     BEGIN_EVENT_TABLE (Frame, wxFrame)
         EVT_BUTTON (ClearButton, Frame::OnClearButtonClicked)
         EVT_BUTTON (DrawPolygonButton, Frame::OnDrawPolygonButtonClicked)
+        EVT_THREAD (PolygonCalculatedEvent, Frame::OnPolygonCalculated)
+        EVT_CHECKBOX (LivePolygonCheckBox, Frame::OnLivePolygonCheckBoxClicked)
+        EVT_TIMER (LiveUpdateTimer, Frame::OnLiveUpdateTimer)
+#if defined (GEOMETRY_INSTRUMENTATION)
+        EVT_BUTTON (StatisticsButton, Frame::OnStatisticsButtonClicked)
+        EVT_THREAD (StatisticsCalculatedEvent, Frame::OnStatisticsCalculated)
+#endif
         END_EVENT_TABLE ()
 
 
     Frame::Frame () :
         wxFrame (nullptr, -1, wxString::FromUTF8 (Resources::DialogTitle),
-                 DefaultAppPosition, DefaultAppSize, wxDEFAULT_FRAME_STYLE^ wxRESIZE_BORDER)
+                 DefaultAppPosition, DefaultAppSize, wxDEFAULT_FRAME_STYLE^ wxRESIZE_BORDER),
+        polygonCalculator (*this, PolygonCalculatedEvent),
+        liveUpdateTimer (this, LiveUpdateTimer)
     {
     }
 
@@ -39,6 +58,12 @@ namespace UI
                                           ClearButtonPosition, ClearButtonSize);
         drawPolygonButton = new wxButton (this, DrawPolygonButton, wxString::FromUTF8 (Resources::DrawPolygonButtonText),
                                           DrawButtonPosition, DrawButtonSize);
+        livePolygonCheckBox = new wxCheckBox (this, LivePolygonCheckBox, wxString::FromUTF8 (Resources::LivePolygonCheckBoxText),
+                                              LivePolygonCheckBoxPosition, LivePolygonCheckBoxSize);
+#if defined (GEOMETRY_INSTRUMENTATION)
+        new wxButton (this, StatisticsButton, wxString::FromUTF8 (Resources::StatisticsButtonText),
+                      StatisticsButtonPosition, StatisticsButtonSize);
+#endif
         clearCanvasButton->Enable (false);
         drawPolygonButton->Enable (false);
         SetAutoLayout (true);
@@ -52,14 +77,77 @@ namespace UI
     }
 
 
+    // the polygon is calculated on the worker thread from a snapshot, so the window does not freeze
     void Frame::OnDrawPolygonButtonClicked (wxCommandEvent& event)
     {
-        if (canvas->GetCurrentPointSet ().size () < 3)
+        if (canvas->GetPointSetSummary ().GetPointCount () < 3 || canvas->IsPolygonUpToDate ())
+            return;
+
+        polygonCalculator.Calculate (canvas->GetCurrentBoundingPolygon ().GetSnapshot (), canvas->GetPointSetVersion ());
+    }
+
+
+    // the result is dropped if the points have changed since the calculation was started
+    void Frame::OnPolygonCalculated (wxThreadEvent& event)
+    {
+        const PolygonCalculationResult result = event.GetPayload<PolygonCalculationResult> ();
+        if (result.pointSetVersion != canvas->GetPointSetVersion () || result.polygon.empty ())
+            return;
+
+        canvas->DrawNewPolygon (result.polygon);
+    }
+
+
+    void Frame::OnLivePolygonCheckBoxClicked (wxCommandEvent& event)
+    {
+        if (livePolygonCheckBox->GetValue ())
+            PolygonOutdated ();
+        else
+            liveUpdateTimer.Stop ();
+    }
+
+
+    // the latest calculation cancels the previous one, so at most one calculation is pending at any time
+    void Frame::OnLiveUpdateTimer (wxTimerEvent& event)
+    {
+        if (!livePolygonCheckBox->GetValue () || canvas->GetPointSetSummary ().GetPointCount () < 3 || canvas->IsPolygonUpToDate ())
             return;
 
-        Model::UIPolygon polygonPoints = Logic::CalculateBoundingPolygon (canvas->GetCurrentPointSet ());
-        canvas->DrawNewPolygon (polygonPoints);
+        polygonCalculator.Calculate (canvas->GetCurrentBoundingPolygon ().GetSnapshot (), canvas->GetPointSetVersion ());
+    }
+
+
+#if defined (GEOMETRY_INSTRUMENTATION)
+    // the drawn polygon comes from the dynamic polygon, which does not collect statistics
+    // so the points are copied, and a separate gift wrapping run measures them on a background thread
+    void Frame::OnStatisticsButtonClicked (wxCommandEvent& event)
+    {
+        polygonCalculator.MeasureStatistics (canvas->GetCurrentPointSet (), StatisticsCalculatedEvent);
+    }
+
+
+    void Frame::OnStatisticsCalculated (wxThreadEvent& event)
+    {
+        const PolygonStatisticsResult result = event.GetPayload<PolygonStatisticsResult> ();
+        std::ostringstream text;
+        text << Resources::StatisticsRunText << "\n"
+             << "Points: " << result.pointCount << "\n\n";
+        if (!result.isPolygon) {
+            text << Resources::NoPolygonText;
+        } else {
+            const Geometry::BoundingPolygonStatistics& statistics = result.statistics;
+            text << "Wrap iterations: " << statistics.wrapIterationCount << "\n"
+                 << "Examined points: " << statistics.examinedPointCount << "\n"
+                 << "Orientation tests: " << statistics.orientationTestCount << "\n"
+                 << "Slope comparisons: " << statistics.slopeComparisonCount << "\n"
+                 << "Vertical line cases: " << statistics.verticalLineCaseCount << "\n"
+                 << "Validation: " << statistics.validationNanoseconds / 1000 << " us\n"
+                 << "Preprocessing: " << statistics.preprocessingNanoseconds / 1000 << " us\n"
+                 << "Search: " << statistics.searchNanoseconds / 1000 << " us";
+        }
+        wxMessageBox (wxString::FromUTF8 (text.str ().c_str ()), wxString::FromUTF8 (Resources::StatisticsButtonText), wxOK, this);
     }
+#endif
 
 
     void Frame::SetClearCanvasButtonState (bool newState)
@@ -73,4 +161,12 @@ namespace UI
         drawPolygonButton->Enable (newState);
     }
 
+
+    // in live mode the polygon is recalculated in the next frame, the changes until then do not start more calculations
+    void Frame::PolygonOutdated ()
+    {
+        if (livePolygonCheckBox->GetValue () && !liveUpdateTimer.IsRunning ())
+            liveUpdateTimer.StartOnce (LiveUpdateInterval);
+    }
+
 }
\ No newline at end of file
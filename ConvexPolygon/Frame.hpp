@@ -5,6 +5,7 @@
 #include <wx/wxprec.h>
 
 #include "ButtonStateNotifier.hpp"
+#include "PolygonCalculator.hpp"
 
 namespace UI
 {
@@ -16,7 +17,12 @@ namespace UI
         enum
         {
             ClearButton = wxID_HIGHEST + 1,
-            DrawPolygonButton = wxID_HIGHEST + 2
+            DrawPolygonButton = wxID_HIGHEST + 2,
+            StatisticsButton = wxID_HIGHEST + 3,
+            PolygonCalculatedEvent = wxID_HIGHEST + 4,
+            LivePolygonCheckBox = wxID_HIGHEST + 5,
+            LiveUpdateTimer = wxID_HIGHEST + 6,
+            StatisticsCalculatedEvent = wxID_HIGHEST + 7
         };
 
         Frame ();
@@ -24,13 +30,24 @@ namespace UI
         void CreateUIElements ();
         void OnClearButtonClicked (wxCommandEvent& event);
         void OnDrawPolygonButtonClicked (wxCommandEvent& event);
+        void OnPolygonCalculated (wxThreadEvent& event);
+        void OnLivePolygonCheckBoxClicked (wxCommandEvent& event);
+        void OnLiveUpdateTimer (wxTimerEvent& event);
+#if defined (GEOMETRY_INSTRUMENTATION)
+        void OnStatisticsButtonClicked (wxCommandEvent& event);
+        void OnStatisticsCalculated (wxThreadEvent& event);
+#endif
 
         virtual void SetClearCanvasButtonState (bool newState) override;
         virtual void SetDrawPolygonButtonState (bool newState) override;
+        virtual void PolygonOutdated () override;
 
         UI::Canvas* canvas;
         wxButton* clearCanvasButton;
         wxButton* drawPolygonButton;
+        wxCheckBox* livePolygonCheckBox;
+        PolygonCalculator polygonCalculator;
+        wxTimer liveUpdateTimer;
 
         DECLARE_EVENT_TABLE ()
     };
@@ -1,12 +1,104 @@
 #include "Geometry.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <optional>
+#include <thread>
+
+#if defined (GEOMETRY_INSTRUMENTATION)
+#include <chrono>
+#endif
+
+#include "WorkStealingPool.hpp"
+
+// the vectorized kernels are compiled for their own instruction set and selected at runtime, so no compiler flags are needed
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+#define GEOMETRY_X86
+#include <immintrin.h>
+#if defined (_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined (GEOMETRY_X86) && (defined (__GNUC__) || defined (__clang__))
+#define GEOMETRY_TARGET(instructionSet) __attribute__ ((target (instructionSet)))
+#else
+#define GEOMETRY_TARGET(instructionSet)
+#endif
 
 namespace Geometry
 {
-    const double EPS = 0.00001;
+#if defined (GEOMETRY_INSTRUMENTATION)
+    enum class StatisticsPhase
+    {
+        None,
+        Validation,
+        Preprocessing,
+        Search
+    };
+
+
+    static thread_local BoundingPolygonStatistics statistics;
+    static thread_local StatisticsPhase currentPhase = StatisticsPhase::None;
+    static thread_local std::chrono::steady_clock::time_point phaseStartTime;
+
+
+    // the time since the previous phase change is added to the previous phase
+    static void StartStatisticsPhase (StatisticsPhase phase)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+        const long long elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds> (now - phaseStartTime).count ();
+        switch (currentPhase) {
+            case StatisticsPhase::Validation:
+                statistics.validationNanoseconds += elapsedNanoseconds;
+                break;
+            case StatisticsPhase::Preprocessing:
+                statistics.preprocessingNanoseconds += elapsedNanoseconds;
+                break;
+            case StatisticsPhase::Search:
+                statistics.searchNanoseconds += elapsedNanoseconds;
+                break;
+            case StatisticsPhase::None:
+                break;
+        }
+        currentPhase = phase;
+        phaseStartTime = now;
+    }
+
+
+    static void StartStatistics (StatisticsPhase firstPhase)
+    {
+        statistics = BoundingPolygonStatistics ();
+        currentPhase = StatisticsPhase::None;
+        StartStatisticsPhase (firstPhase);
+    }
+
+#define GEOMETRY_START_STATISTICS(firstPhase) StartStatistics (StatisticsPhase::firstPhase)
+#define GEOMETRY_START_PHASE(phase) StartStatisticsPhase (StatisticsPhase::phase)
+#define GEOMETRY_FINISH_STATISTICS() StartStatisticsPhase (StatisticsPhase::None)
+#define GEOMETRY_COUNT(counter, count) (statistics.counter += (count))
+#else
+#define GEOMETRY_START_STATISTICS(firstPhase) ((void) 0)
+#define GEOMETRY_START_PHASE(phase) ((void) 0)
+#define GEOMETRY_FINISH_STATISTICS() ((void) 0)
+#define GEOMETRY_COUNT(counter, count) ((void) 0)
+#endif
+
+
+    // all of the values are 0 if the instrumentation is not compiled in
+    BoundingPolygonStatistics GetLastBoundingPolygonStatistics ()
+    {
+#if defined (GEOMETRY_INSTRUMENTATION)
+        return statistics;
+#else
+        return BoundingPolygonStatistics ();
+#endif
+    }
+
 
     bool Point::operator== (const Point& otherPoint) const
     {
@@ -20,6 +112,12 @@ namespace Geometry
     }
 
 
+    bool PointComparator::operator() (const Point& point1, const Point& point2) const
+    {
+        return point1.x < point2.x || (point1.x == point2.x && point1.y < point2.y);
+    }
+
+
     GeneralLine::~GeneralLine () = default;
 
 
@@ -43,6 +141,28 @@ namespace Geometry
     }
 
 
+    PointSource::~PointSource () = default;
+
+
+    // calls the visitor for every point of a container, or for every point of every chunk of a point source
+    template <typename PointContainer, typename PointVisitor>
+    static void ForEachPoint (const PointContainer& points, const PointVisitor& visitPoint)
+    {
+        for (const Point& point : points)
+            visitPoint (point);
+    }
+
+
+    template <typename PointVisitor>
+    static void ForEachPoint (const PointSource& points, const PointVisitor& visitPoint)
+    {
+        points.VisitPoints ([&visitPoint] (PointSpan chunk) {
+            for (const Point& point : chunk)
+                visitPoint (point);
+        });
+    }
+
+
     // if multiple points have the same x coord, return the bottom one
     Point FindLeftMostPoint (const PointSet& points)
     {
@@ -61,67 +181,176 @@ namespace Geometry
     }
 
 
-    struct NextPointAnalysisCache
+    // a difference of two int coords needs 33 bits, so the product of two differences does not fit into a long long
+    // the products are calculated with 128 bit signed integers, which are exact for any int coords
+#if defined (__SIZEOF_INT128__)
+    __extension__ typedef __int128 WideInteger;
+#else
+    // two's complement 128 bit integer, the operations wrap around like the built-in unsigned types
+    class WideInteger
     {
-        using SlopePointMap = std::unordered_map<Point, double, GeometryPointHashFunction>;
+        unsigned long long high;
+        unsigned long long low;
+
+        WideInteger (unsigned long long high, unsigned long long low) : high (high), low (low) {}
+
+        // the full 128 bit product of two 64 bit values, calculated from 32 bit halves
+        static WideInteger MultiplyHalves (unsigned long long value1, unsigned long long value2)
+        {
+            const unsigned long long lowProduct = (value1 & 0xffffffffull) * (value2 & 0xffffffffull);
+            const unsigned long long middleProduct1 = (value1 >> 32) * (value2 & 0xffffffffull);
+            const unsigned long long middleProduct2 = (value1 & 0xffffffffull) * (value2 >> 32);
+            const unsigned long long highProduct = (value1 >> 32) * (value2 >> 32);
+            const unsigned long long middleSum = (lowProduct >> 32) + (middleProduct1 & 0xffffffffull) + (middleProduct2 & 0xffffffffull);
+            return WideInteger (highProduct + (middleProduct1 >> 32) + (middleProduct2 >> 32) + (middleSum >> 32),
+                                (middleSum << 32) | (lowProduct & 0xffffffffull));
+        }
 
-        const Point& startPoint;
-        SlopePointMap slopeValuesForMathematicalPoints;
-        PointSet verticalLinePointSet;
-        int maxXCoord;
-        int minXCoord;
+        // the sign bit is flipped, so the high parts can be compared as unsigned values
+        unsigned long long GetOrderedHigh () const
+        {
+            return high ^ (1ull << 63);
+        }
+    public:
+        WideInteger (long long value) : high (value < 0 ? ~0ull : 0ull), low ((unsigned long long)value) {}
+
+        friend WideInteger operator+ (const WideInteger& value1, const WideInteger& value2)
+        {
+            const unsigned long long low = value1.low + value2.low;
+            return WideInteger (value1.high + value2.high + (low < value1.low ? 1 : 0), low);
+        }
+
+        friend WideInteger operator- (const WideInteger& value1, const WideInteger& value2)
+        {
+            return WideInteger (value1.high - value2.high - (value1.low < value2.low ? 1 : 0), value1.low - value2.low);
+        }
+
+        friend WideInteger operator- (const WideInteger& value)
+        {
+            return WideInteger (0) - value;
+        }
+
+        friend WideInteger operator* (const WideInteger& value1, const WideInteger& value2)
+        {
+            const WideInteger lowProduct = MultiplyHalves (value1.low, value2.low);
+            return WideInteger (lowProduct.high + value1.high * value2.low + value1.low * value2.high, lowProduct.low);
+        }
+
+        friend bool operator== (const WideInteger& value1, const WideInteger& value2) { return value1.high == value2.high && value1.low == value2.low; }
+        friend bool operator!= (const WideInteger& value1, const WideInteger& value2) { return !(value1 == value2); }
+        friend bool operator< (const WideInteger& value1, const WideInteger& value2)
+        {
+            return value1.GetOrderedHigh () < value2.GetOrderedHigh () || (value1.high == value2.high && value1.low < value2.low);
+        }
+        friend bool operator> (const WideInteger& value1, const WideInteger& value2) { return value2 < value1; }
+        friend bool operator<= (const WideInteger& value1, const WideInteger& value2) { return !(value2 < value1); }
+        friend bool operator>= (const WideInteger& value1, const WideInteger& value2) { return !(value1 < value2); }
     };
+#endif
 
 
-    static NextPointAnalysisCache DoPreprocessingForNextPointSearch (const PointSet& points, const Point& startPoint)
+    static WideInteger Multiply (long long value1, long long value2)
     {
-        NextPointAnalysisCache nextPointChache {startPoint};
-        nextPointChache.maxXCoord = startPoint.x;
-        nextPointChache.minXCoord = startPoint.x;
+        return WideInteger (value1) * value2;
+    }
 
-        for (const Point& point : points) {
-            if (point.x > nextPointChache.maxXCoord)
-                nextPointChache.maxXCoord = point.x;
-            if (point.x < nextPointChache.minXCoord)
-                nextPointChache.minXCoord = point.x;
 
-            const std::unique_ptr<GeneralLine> line = GeneralLine::CreateLine (startPoint, point);
-            const MathematicalLine* mathematicalLine = dynamic_cast<MathematicalLine*>(line.get ());
-            if (mathematicalLine != nullptr) {
-                nextPointChache.slopeValuesForMathematicalPoints[point] = mathematicalLine->slope;
-            } else {
-                nextPointChache.verticalLinePointSet.insert (point);
-            }
-        }
-        return nextPointChache;
+    static int GetSign (const WideInteger& value)
+    {
+        return value > 0 ? 1 : (value < 0 ? -1 : 0);
     }
 
 
-    static Point FindPointWithLowestYCoord (const PointSet& points, const Point& startPoint)
+    // positive if the turn from point1 through point2 to point3 is counter-clockwise, negative if clockwise, 0 if collinear
+    // exact for any int coords
+    static WideInteger CrossProduct (const Point& point1, const Point& point2, const Point& point3)
     {
-        int minYCoord = startPoint.y;
-        Point pointWithLowestYCoord = startPoint;
-        for (const Point& point : points) {
-            if (point.y < minYCoord) {
-                minYCoord = point.y;
-                pointWithLowestYCoord = point;
+        GEOMETRY_COUNT (orientationTestCount, 1);
+        return Multiply ((long long)point2.x - point1.x, (long long)point3.y - point1.y) -
+               Multiply ((long long)point2.y - point1.y, (long long)point3.x - point1.x);
+    }
+
+
+    Orientation GetOrientation (const Point& point1, const Point& point2, const Point& point3)
+    {
+        const WideInteger crossProduct = CrossProduct (point1, point2, point3);
+        if (crossProduct > 0)
+            return Orientation::CounterClockwise;
+        if (crossProduct < 0)
+            return Orientation::Clockwise;
+        return Orientation::Collinear;
+    }
+
+
+    // compares the slopes of the lines startPoint-point1 and startPoint-point2 without division
+    // both points have to be on the same side of the vertical line going through startPoint
+    static WideInteger CompareSlopes (const Point& startPoint, const Point& point1, const Point& point2)
+    {
+        assert (point1.x != startPoint.x && point2.x != startPoint.x);
+        assert ((point1.x > startPoint.x) == (point2.x > startPoint.x));
+        GEOMETRY_COUNT (slopeComparisonCount, 1);
+
+        return Multiply ((long long)point1.y - startPoint.y, (long long)point2.x - startPoint.x) -
+               Multiply ((long long)point2.y - startPoint.y, (long long)point1.x - startPoint.x);
+    }
+
+
+    struct NextPointAnalysisCache
+    {
+        const Point& startPoint;
+        int maxXCoord;
+        int minXCoord;
+        Point pointWithLowestYCoordOnVerticalLine;
+        Point pointWithHighestYCoordOnVerticalLine;
+        std::optional<Point> pointWithSmallestSlope;
+    };
+
+
+    // if multiple points result in the same slope, choose the farthest point
+    static void UpdatePointWithSmallestSlope (NextPointAnalysisCache& nextPointCache, const Point& point, SearchDirection searchDirection)
+    {
+        if (!nextPointCache.pointWithSmallestSlope.has_value ()) {
+            nextPointCache.pointWithSmallestSlope = point;
+            return;
+        }
+
+        const Point& pointWithSmallestSlope = nextPointCache.pointWithSmallestSlope.value ();
+        const WideInteger slopeComparison = CompareSlopes (nextPointCache.startPoint, point, pointWithSmallestSlope);
+        if (slopeComparison < 0) {
+            nextPointCache.pointWithSmallestSlope = point;
+        } else if (slopeComparison == 0) {
+            if (searchDirection == SearchDirection::Right) {
+                if (point.x > pointWithSmallestSlope.x)
+                    nextPointCache.pointWithSmallestSlope = point;
+            } else {
+                if (point.x < pointWithSmallestSlope.x)
+                    nextPointCache.pointWithSmallestSlope = point;
             }
         }
-        return pointWithLowestYCoord;
     }
 
 
-    static Point FindPointWithHighestYCoord (const PointSet& points, const Point& startPoint)
+    template <typename PointContainer>
+    static NextPointAnalysisCache DoPreprocessingForNextPointSearch (const PointContainer& points, const Point& startPoint, SearchDirection searchDirection)
     {
-        int maxYCoord = startPoint.y;
-        Point pointWithHighestYCoord = startPoint;
-        for (const Point& point : points) {
-            if (point.y > maxYCoord) {
-                maxYCoord = point.y;
-                pointWithHighestYCoord = point;
+        NextPointAnalysisCache nextPointChache {startPoint, startPoint.x, startPoint.x, startPoint, startPoint, std::nullopt};
+        ForEachPoint (points, [&] (const Point& point) {
+            GEOMETRY_COUNT (examinedPointCount, 1);
+            if (point.x > nextPointChache.maxXCoord)
+                nextPointChache.maxXCoord = point.x;
+            if (point.x < nextPointChache.minXCoord)
+                nextPointChache.minXCoord = point.x;
+
+            if (point.x == startPoint.x) {
+                if (point.y < nextPointChache.pointWithLowestYCoordOnVerticalLine.y)
+                    nextPointChache.pointWithLowestYCoordOnVerticalLine = point;
+                if (point.y > nextPointChache.pointWithHighestYCoordOnVerticalLine.y)
+                    nextPointChache.pointWithHighestYCoordOnVerticalLine = point;
+            } else if ((searchDirection == SearchDirection::Right) == (point.x > startPoint.x)) {
+                UpdatePointWithSmallestSlope (nextPointChache, point, searchDirection);
             }
-        }
-        return pointWithHighestYCoord;
+        });
+        return nextPointChache;
     }
 
 
@@ -133,14 +362,10 @@ namespace Geometry
         if (isStartPointOnRightEdge && isStartPointOnLeftEdge)
             return true;
 
-        if (isStartPointOnRightEdge) {
-            Point highestYPoint = FindPointWithHighestYCoord (nextPointCache.verticalLinePointSet, nextPointCache.startPoint);
-            return highestYPoint.y > nextPointCache.startPoint.y;
-        }       
-        if (isStartPointOnLeftEdge) {
-            Point lowestYPoint = FindPointWithLowestYCoord (nextPointCache.verticalLinePointSet, nextPointCache.startPoint);
-            return lowestYPoint.y < nextPointCache.startPoint.y;
-        }
+        if (isStartPointOnRightEdge)
+            return nextPointCache.pointWithHighestYCoordOnVerticalLine.y > nextPointCache.startPoint.y;
+        if (isStartPointOnLeftEdge)
+            return nextPointCache.pointWithLowestYCoordOnVerticalLine.y < nextPointCache.startPoint.y;
         return false;
     }
 
@@ -149,62 +374,214 @@ namespace Geometry
     {
         const bool leftSide = nextPointCache.minXCoord == nextPointCache.startPoint.x;
         if (leftSide) {
-            return FindPointWithLowestYCoord (nextPointCache.verticalLinePointSet, nextPointCache.startPoint);
+            return nextPointCache.pointWithLowestYCoordOnVerticalLine;
         } else {
-            return FindPointWithHighestYCoord (nextPointCache.verticalLinePointSet, nextPointCache.startPoint);
+            return nextPointCache.pointWithHighestYCoordOnVerticalLine;
         }
     }
 
 
-    // if multiple points result in the same slope, choose the farthest point
-    static Point FindPointWithSmallestSlope (const NextPointAnalysisCache& nextPointCache, SearchDirection searchDirection)
+    template <typename PointContainer>
+    static Point FindNextPoint (const PointContainer& points, const Point& startPoint, SearchDirection searchDirection)
     {
-        assert (nextPointCache.slopeValuesForMathematicalPoints.size () > 0);
-
-        std::optional<Point> pointWithSmallestSlope;
-        std::optional<double> smallestSlope;
-        for (const auto& [point, slope] : nextPointCache.slopeValuesForMathematicalPoints) {
-            if (searchDirection == SearchDirection::Right && point.x < nextPointCache.startPoint.x)
-                continue;
-            if (searchDirection == SearchDirection::Left && point.x > nextPointCache.startPoint.x)
-                continue;
-
-            if (!smallestSlope.has_value ()) {
-                smallestSlope = slope;
-                pointWithSmallestSlope = point;
-                continue;
-            }
+        GEOMETRY_COUNT (wrapIterationCount, 1);
+        const NextPointAnalysisCache nextPointCache = DoPreprocessingForNextPointSearch (points, startPoint, searchDirection);
 
-            if (slope < smallestSlope.value ()) {
-                smallestSlope = slope;
-                pointWithSmallestSlope = point;
-            } else if (slope == smallestSlope.value ()) {
-                if (searchDirection == SearchDirection::Right) {
-                    if (point.x > pointWithSmallestSlope.value ().x)
-                        pointWithSmallestSlope = point;
-                } else {
-                    if (point.x < pointWithSmallestSlope.value ().x)
-                        pointWithSmallestSlope = point;
-                }
-            }
+        if (IsLineVerticalToNextPoint (nextPointCache)) {
+            GEOMETRY_COUNT (verticalLineCaseCount, 1);
+            return HandleVerticalLinesOnEdges (nextPointCache);
         }
-        assert (pointWithSmallestSlope.has_value ());
-        return pointWithSmallestSlope.value ();
+
+        assert (nextPointCache.pointWithSmallestSlope.has_value ());
+        return nextPointCache.pointWithSmallestSlope.value ();
     }
 
 
     // assumes that the startPoint is correct
     Point FindNextPointInBoundingPolygon (const PointSet& points, const Point& startPoint, SearchDirection searchDirection)
     {
+        GEOMETRY_START_STATISTICS (Validation);
         assert (points.size () > 0);
         assert (points.find (startPoint) == points.end ());
 
-        NextPointAnalysisCache nextPointCache = DoPreprocessingForNextPointSearch (points, startPoint);
+        GEOMETRY_START_PHASE (Search);
+        const Point nextPoint = FindNextPoint (points, startPoint, searchDirection);
+        GEOMETRY_FINISH_STATISTICS ();
+        return nextPoint;
+    }
 
-        if (IsLineVerticalToNextPoint (nextPointCache))
-            return HandleVerticalLinesOnEdges (nextPointCache);
 
-        return FindPointWithSmallestSlope (nextPointCache, searchDirection);
+    PointBounds CalculatePointBounds (const PointSet& points)
+    {
+        assert (points.size () > 0);
+
+        const Point& firstPoint = *points.begin ();
+        PointBounds bounds {firstPoint.x, firstPoint.x, firstPoint.y, firstPoint.y};
+        for (const Point& point : points) {
+            bounds.minXCoord = std::min (bounds.minXCoord, point.x);
+            bounds.maxXCoord = std::max (bounds.maxXCoord, point.x);
+            bounds.minYCoord = std::min (bounds.minYCoord, point.y);
+            bounds.maxYCoord = std::max (bounds.maxYCoord, point.y);
+        }
+        return bounds;
+    }
+
+
+    static_assert (sizeof (Point) == 2 * sizeof (int), "the coords of a point array have to form a contiguous int array");
+
+
+    static VectorInstructionSet DetectVectorInstructionSet ()
+    {
+#if defined (GEOMETRY_X86) && (defined (__GNUC__) || defined (__clang__))
+        __builtin_cpu_init ();
+        if (__builtin_cpu_supports ("avx2"))
+            return VectorInstructionSet::AVX2;
+        if (__builtin_cpu_supports ("sse4.1"))
+            return VectorInstructionSet::SSE41;
+        return VectorInstructionSet::None;
+#elif defined (GEOMETRY_X86) && defined (_MSC_VER)
+        int cpuInfo[4];
+        __cpuid (cpuInfo, 0);
+        const int maxLeaf = cpuInfo[0];
+        __cpuid (cpuInfo, 1);
+        const bool hasSse41 = (cpuInfo[2] & (1 << 19)) != 0;
+        // AVX2 also needs the operating system to save the ymm registers (OSXSAVE, AVX and the xmm and ymm states in XCR0)
+        bool hasAvx2 = false;
+        if (maxLeaf >= 7 && (cpuInfo[2] & (1 << 27)) != 0 && (cpuInfo[2] & (1 << 28)) != 0 && (_xgetbv (0) & 6) == 6) {
+            __cpuidex (cpuInfo, 7, 0);
+            hasAvx2 = (cpuInfo[1] & (1 << 5)) != 0;
+        }
+        if (hasAvx2)
+            return VectorInstructionSet::AVX2;
+        if (hasSse41)
+            return VectorInstructionSet::SSE41;
+        return VectorInstructionSet::None;
+#else
+        return VectorInstructionSet::None;
+#endif
+    }
+
+
+    static std::atomic<VectorInstructionSet> vectorInstructionSetLimit (VectorInstructionSet::AVX2);
+
+
+    VectorInstructionSet GetVectorInstructionSet ()
+    {
+        static const VectorInstructionSet supportedInstructionSet = DetectVectorInstructionSet ();
+        return std::min (supportedInstructionSet, vectorInstructionSetLimit.load (std::memory_order_relaxed));
+    }
+
+
+    void LimitVectorInstructionSet (VectorInstructionSet instructionSet)
+    {
+        vectorInstructionSetLimit.store (instructionSet, std::memory_order_relaxed);
+    }
+
+
+#if defined (GEOMETRY_X86)
+    // the even lanes contain x coords, the odd lanes contain y coords
+    static void UpdatePointBoundsWithLanes (PointBounds& bounds, const int* minCoords, const int* maxCoords, size_t laneCount)
+    {
+        for (size_t lane = 0; lane < laneCount; lane += 2) {
+            bounds.minXCoord = std::min (bounds.minXCoord, minCoords[lane]);
+            bounds.maxXCoord = std::max (bounds.maxXCoord, maxCoords[lane]);
+            bounds.minYCoord = std::min (bounds.minYCoord, minCoords[lane + 1]);
+            bounds.maxYCoord = std::max (bounds.maxYCoord, maxCoords[lane + 1]);
+        }
+    }
+
+
+    // returns the number of processed points, at least four points are needed
+    GEOMETRY_TARGET ("avx2")
+    static size_t CalculatePointBoundsWithAvx2 (const int* coords, size_t pointCount, PointBounds& bounds)
+    {
+        __m256i minVector = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (coords));
+        __m256i maxVector = minVector;
+        size_t index = 4;
+        for (; index + 4 <= pointCount; index += 4) {
+            const __m256i coordVector = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (coords + 2 * index));
+            minVector = _mm256_min_epi32 (minVector, coordVector);
+            maxVector = _mm256_max_epi32 (maxVector, coordVector);
+        }
+        alignas (32) int minCoords[8];
+        alignas (32) int maxCoords[8];
+        _mm256_store_si256 (reinterpret_cast<__m256i*> (minCoords), minVector);
+        _mm256_store_si256 (reinterpret_cast<__m256i*> (maxCoords), maxVector);
+        UpdatePointBoundsWithLanes (bounds, minCoords, maxCoords, 8);
+        return index;
+    }
+
+
+    // returns the number of processed points, at least two points are needed
+    GEOMETRY_TARGET ("sse4.1")
+    static size_t CalculatePointBoundsWithSse41 (const int* coords, size_t pointCount, PointBounds& bounds)
+    {
+        __m128i minVector = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (coords));
+        __m128i maxVector = minVector;
+        size_t index = 2;
+        for (; index + 2 <= pointCount; index += 2) {
+            const __m128i coordVector = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (coords + 2 * index));
+            minVector = _mm_min_epi32 (minVector, coordVector);
+            maxVector = _mm_max_epi32 (maxVector, coordVector);
+        }
+        alignas (16) int minCoords[4];
+        alignas (16) int maxCoords[4];
+        _mm_store_si128 (reinterpret_cast<__m128i*> (minCoords), minVector);
+        _mm_store_si128 (reinterpret_cast<__m128i*> (maxCoords), maxVector);
+        UpdatePointBoundsWithLanes (bounds, minCoords, maxCoords, 4);
+        return index;
+    }
+#endif
+
+
+    // the point array is processed as one int array (x, y, x, y, ...), so a vector register holds the coords of several points
+    // AVX2 or SSE4.1 is used if the CPU supports it, otherwise the plain loop is used for every point
+    PointBounds CalculatePointBounds (const Point* points, size_t pointCount)
+    {
+        assert (pointCount > 0);
+
+        const int* coords = reinterpret_cast<const int*> (points);
+        PointBounds bounds {points[0].x, points[0].x, points[0].y, points[0].y};
+        size_t index = 0;
+
+#if defined (GEOMETRY_X86)
+        const VectorInstructionSet instructionSet = GetVectorInstructionSet ();
+        if (instructionSet == VectorInstructionSet::AVX2 && pointCount >= 4)
+            index = CalculatePointBoundsWithAvx2 (coords, pointCount, bounds);
+        else if (instructionSet >= VectorInstructionSet::SSE41 && pointCount >= 2)
+            index = CalculatePointBoundsWithSse41 (coords, pointCount, bounds);
+#endif
+
+        for (; index < pointCount; index++) {
+            bounds.minXCoord = std::min (bounds.minXCoord, coords[2 * index]);
+            bounds.maxXCoord = std::max (bounds.maxXCoord, coords[2 * index]);
+            bounds.minYCoord = std::min (bounds.minYCoord, coords[2 * index + 1]);
+            bounds.maxYCoord = std::max (bounds.maxYCoord, coords[2 * index + 1]);
+        }
+        return bounds;
+    }
+
+
+    static PointBounds CalculatePointBounds (PointSpan points)
+    {
+        return CalculatePointBounds (points.data, points.size);
+    }
+
+
+    PointBounds CalculatePointBounds (const PointSource& points)
+    {
+        assert (points.GetPointCount () > 0);
+
+        const int maxInt = std::numeric_limits<int>::max ();
+        const int minInt = std::numeric_limits<int>::min ();
+        PointBounds bounds {maxInt, minInt, maxInt, minInt};
+        ForEachPoint (points, [&bounds] (const Point& point) {
+            bounds.minXCoord = std::min (bounds.minXCoord, point.x);
+            bounds.maxXCoord = std::max (bounds.maxXCoord, point.x);
+            bounds.minYCoord = std::min (bounds.minYCoord, point.y);
+            bounds.maxYCoord = std::max (bounds.maxYCoord, point.y);
+        });
+        return bounds;
     }
 
 
@@ -213,175 +590,1663 @@ namespace Geometry
         if (points.size () < 3)
             return true;
 
-        const Point point = *points.begin ();
-        const int y = point.y;
-        const int x = point.x;
+        const PointBounds bounds = CalculatePointBounds (points);
+        return bounds.minXCoord == bounds.maxXCoord || bounds.minYCoord == bounds.maxYCoord;
+    }
 
-        bool sameYCoords = true;
-        bool sameXCoords = true;
 
-        for (const Point& point : points) {
-            if (sameYCoords && point.y != y)
-                sameYCoords = false;
-            if (sameXCoords && point.x != x)
-                sameXCoords = false;
-        }
+    bool AreAllPointsInOneLine (PointSpan points)
+    {
+        if (points.size < 3)
+            return true;
 
-        return sameYCoords || sameXCoords;
+        const PointBounds bounds = CalculatePointBounds (points.data, points.size);
+        return bounds.minXCoord == bounds.maxXCoord || bounds.minYCoord == bounds.maxYCoord;
     }
 
 
-    static int FindMaxXCoord (const PointSet& points)
+    bool AreAllPointsInOneLine (const PointSource& points)
     {
-        assert (points.size () > 0);
+        if (points.GetPointCount () < 3)
+            return true;
+
+        const PointBounds bounds = CalculatePointBounds (points);
+        return bounds.minXCoord == bounds.maxXCoord || bounds.minYCoord == bounds.maxYCoord;
+    }
+
+
+    // if multiple points have the same x coord, return the bottom one
+    Point FindLeftMostPoint (PointSpan points)
+    {
+        assert (points.size > 0);
 
-        int maxXCoord = (*points.begin ()).x;
+        const int minXCoord = CalculatePointBounds (points.data, points.size).minXCoord;
+        Point leftMostPoint = *std::find_if (points.begin (), points.end (),
+                                             [minXCoord] (const Point& point) { return point.x == minXCoord; });
         for (const Point& point : points) {
-            if (point.x > maxXCoord) {
-                maxXCoord = point.x;
-            }
+            if (point.x == minXCoord && point.y < leftMostPoint.y)
+                leftMostPoint = point;
         }
-        return maxXCoord;
+        return leftMostPoint;
     }
 
 
-    std::vector<Point> CalculateBoundingPolygon (const PointSet& points)
+    Point FindLeftMostPoint (const PointSource& points)
     {
-        assert (points.size () > 2);
-        assert (!Geometry::AreAllPointsInOneLine (points));
+        assert (points.GetPointCount () > 0);
+
+        Point leftMostPoint (std::numeric_limits<int>::max (), std::numeric_limits<int>::max ());
+        ForEachPoint (points, [&leftMostPoint] (const Point& point) {
+            if (PointComparator () (point, leftMostPoint))
+                leftMostPoint = point;
+        });
+        return leftMostPoint;
+    }
+
+
+    // sorts the points by PointComparator and keeps only one of the equal points
+    void RemoveDuplicatePoints (PointArray& points)
+    {
+        std::sort (points.begin (), points.end (), PointComparator ());
+        points.erase (std::unique (points.begin (), points.end ()), points.end ());
+    }
 
-        const int maxXCoord = FindMaxXCoord (points);
+
+    // the points are searched in place, the corners found so far do not have to be removed from them:
+    // the points with the same x coord as the current corner are only chosen if they are farther up or down,
+    // and every other point is on the same side of the next edge, so they cannot have a smaller slope than the next corner
+    template <typename PointContainer>
+    static std::vector<Point> CalculateBoundingPolygonWithGiftWrapping (const PointContainer& points)
+    {
+        const int maxXCoord = CalculatePointBounds (points).maxXCoord;
         SearchDirection searchDirection = SearchDirection::Right;
         std::vector<Point> boundingPoints;
-        PointSet unusedPoints = points;
 
-        Point leftMostPoint = FindLeftMostPoint (points);
-        unusedPoints.erase (leftMostPoint);
-        Point nextPoint = FindNextPointInBoundingPolygon (unusedPoints, leftMostPoint, searchDirection);
-        if (nextPoint.x == maxXCoord)
-            searchDirection = SearchDirection::Left;
-        unusedPoints.insert (leftMostPoint);
-        boundingPoints.push_back (leftMostPoint);
-
-        while (nextPoint != leftMostPoint) {
+        const Point leftMostPoint = FindLeftMostPoint (points);
+        GEOMETRY_START_PHASE (Search);
+        Point nextPoint = leftMostPoint;
+        do {
             boundingPoints.push_back (nextPoint);
-            unusedPoints.erase (nextPoint);
-            nextPoint = FindNextPointInBoundingPolygon (unusedPoints, nextPoint, searchDirection);
+            nextPoint = FindNextPoint (points, nextPoint, searchDirection);
             if (nextPoint.x == maxXCoord)
                 searchDirection = SearchDirection::Left;
-        }
+        } while (nextPoint != leftMostPoint);
 
         return boundingPoints;
     }
 
 
-    enum class LocationRelativeToLine
+    // Andrew's monotone chain: builds the lower and the upper hull over the points sorted by x (and y) coords
+    static std::vector<Point> CalculateMonotoneChainOfSortedPoints (PointSpan sortedPoints)
     {
-        UnderOrRight,
-        AboveOrLeft,
-        OnLine
-    };
+        if (sortedPoints.size < 2)
+            return std::vector<Point> (sortedPoints.begin (), sortedPoints.end ());
+
+        std::vector<Point> boundingPoints (2 * sortedPoints.size);
+        size_t hullSize = 0;
+        GEOMETRY_COUNT (examinedPointCount, sortedPoints.size);
+        for (const Point& point : sortedPoints) {
+            while (hullSize >= 2 && CrossProduct (boundingPoints[hullSize - 2], boundingPoints[hullSize - 1], point) <= 0)
+                hullSize--;
+            boundingPoints[hullSize++] = point;
+        }
 
+        const size_t lowerHullSize = hullSize + 1;
+        for (size_t index = sortedPoints.size - 1; index > 0; index--) {
+            const Point& point = sortedPoints.data[index - 1];
+            while (hullSize >= lowerHullSize && CrossProduct (boundingPoints[hullSize - 2], boundingPoints[hullSize - 1], point) <= 0)
+                hullSize--;
+            boundingPoints[hullSize++] = point;
+        }
+
+        // the last point is the leftmost point again
+        boundingPoints.resize (hullSize - 1);
+        return boundingPoints;
+    }
 
 
-    struct LineAndLocation
+    // the points are sorted in place
+    static std::vector<Point> CalculateBoundingPolygonWithMonotoneChainInPlace (std::vector<Point>& points)
     {
-        std::unique_ptr<GeneralLine> line;
-        LocationRelativeToLine location;
+        std::sort (points.begin (), points.end (), PointComparator ());
+        GEOMETRY_START_PHASE (Search);
+        return CalculateMonotoneChainOfSortedPoints (points);
+    }
 
-        LineAndLocation (std::unique_ptr<GeneralLine> line, LocationRelativeToLine location) :
-            line (std::move (line)),
-            location (location)
-        { }
-    };
+
+    template <typename PointContainer>
+    static std::vector<Point> CalculateBoundingPolygonWithMonotoneChain (const PointContainer& points)
+    {
+        std::vector<Point> sortedPoints (points.begin (), points.end ());
+        return CalculateBoundingPolygonWithMonotoneChainInPlace (sortedPoints);
+    }
 
 
-    static LocationRelativeToLine GetLocationForLineAndPoint (const std::unique_ptr<GeneralLine>& line, const Point& point)
+    // index of the point in [firstIndex, lastIndex] of a convex chain that touches the tangent from a point preceding these points
+    // if multiple chain points are on the tangent, return the farthest one
+    template <typename ChainAccessor>
+    static size_t FindTangentIndexInChain (const Point& point, size_t firstIndex, size_t lastIndex, const ChainAccessor& getChainPoint, Orientation convexTurn)
     {
-        const MathematicalLine* mathematicalLine = dynamic_cast<MathematicalLine*>(line.get ());
-        if (mathematicalLine != nullptr) {
-            const double yCoordForPointOnLine = mathematicalLine->slope * point.x + mathematicalLine->yOffset;
-            assert (abs(yCoordForPointOnLine - point.y) > EPS);
-            if (yCoordForPointOnLine > point.y)
-                return LocationRelativeToLine::UnderOrRight;
-            else
-                return LocationRelativeToLine::AboveOrLeft;
-        } else {
-            const VerticalLine* verticalLine = static_cast<VerticalLine*>(line.get ());
-            assert (verticalLine->x != point.x);
-            if (verticalLine->x < point.x)
-                return LocationRelativeToLine::UnderOrRight;
+        const long long sign = convexTurn == Orientation::CounterClockwise ? 1 : -1;
+
+        while (firstIndex < lastIndex) {
+            const size_t middleIndex = (firstIndex + lastIndex) / 2;
+            if (sign * CrossProduct (point, getChainPoint (middleIndex), getChainPoint (middleIndex + 1)) <= 0)
+                firstIndex = middleIndex + 1;
             else
-                return LocationRelativeToLine::AboveOrLeft;
+                lastIndex = middleIndex;
         }
-        assert (true);
-        return LocationRelativeToLine::OnLine;
+        return firstIndex;
     }
 
 
-    static std::vector<LineAndLocation> PolygonPointsToLines (const std::vector<Point>& polygon)
+    // the lower and the upper chains of the groups of points, stored one after the other
+    // every chain is sorted by PointComparator
+    struct GroupChains
     {
-        assert (polygon.size () > 2);
+        std::vector<Point> lowerChains;
+        std::vector<Point> upperChains;
+        std::vector<size_t> lowerChainEnds;
+        std::vector<size_t> upperChainEnds;
+    };
 
-        std::vector<LineAndLocation> lines;
-        for (int i = 0; i < polygon.size (); ++i) {
-            const int index1 = i;
-            const int index2 = i == polygon.size () - 1 ? 0 : i + 1;
-            const Point point1 = polygon[index1];
-            const Point point2 = polygon[index2];
-            std::unique_ptr<GeneralLine> line = GeneralLine::CreateLine (point1, point2);
-            int referenceIndex = index2 + 1 == polygon.size () ? 0 : index2 + 1;
-            const LocationRelativeToLine location = GetLocationForLineAndPoint (line, polygon[referenceIndex]);
-            lines.push_back (LineAndLocation (std::move(line), location));
+
+    static void AddGroupChains (GroupChains& groupChains, std::vector<Point>::iterator groupBegin, std::vector<Point>::iterator groupEnd)
+    {
+        std::sort (groupBegin, groupEnd, PointComparator ());
+
+        std::vector<Point>& lowerChains = groupChains.lowerChains;
+        std::vector<Point>& upperChains = groupChains.upperChains;
+        const size_t lowerChainBegin = lowerChains.size ();
+        const size_t upperChainBegin = upperChains.size ();
+        for (auto it = groupBegin; it != groupEnd; ++it) {
+            while (lowerChains.size () >= lowerChainBegin + 2 && CrossProduct (lowerChains[lowerChains.size () - 2], lowerChains.back (), *it) <= 0)
+                lowerChains.pop_back ();
+            lowerChains.push_back (*it);
+
+            while (upperChains.size () >= upperChainBegin + 2 && CrossProduct (upperChains[upperChains.size () - 2], upperChains.back (), *it) >= 0)
+                upperChains.pop_back ();
+            upperChains.push_back (*it);
         }
-        return lines;
+        groupChains.lowerChainEnds.push_back (lowerChains.size ());
+        groupChains.upperChainEnds.push_back (upperChains.size ());
     }
 
 
-    static bool CheckIfPointIsOnTheCorrectSide (const LineAndLocation& lineInfo, const Point& point)
+    // gift wrapping from firstPoint to lastPoint along the lower (CounterClockwise) or the upper (Clockwise) chain
+    // the next corner is chosen from the tangents of the groups, every tangent is found by a binary search
+    // returns false if the chain has more than maxCornerCount corners
+    static bool WrapGroupChains (const GroupChains& groupChains, const Point& firstPoint, const Point& lastPoint,
+                                 Orientation convexTurn, size_t maxCornerCount, std::vector<Point>& chain)
     {
-        const MathematicalLine* mathematicalLine = dynamic_cast<MathematicalLine*>(lineInfo.line.get ());
-        if (mathematicalLine != nullptr) {
-            const double yCoordForPointOnLine = mathematicalLine->slope * point.x + mathematicalLine->yOffset;
-            if (abs(yCoordForPointOnLine - point.y) < EPS)
-                return true;
-            if (yCoordForPointOnLine < point.y && lineInfo.location == LocationRelativeToLine::AboveOrLeft)
-                return true;
-            if (yCoordForPointOnLine > point.y && lineInfo.location == LocationRelativeToLine::UnderOrRight)
-                return true;
-        } else {
-            const VerticalLine* verticalLine = static_cast<VerticalLine*>(lineInfo.line.get ());
-            if (verticalLine->x == point.x)
-                return true;
-            if (verticalLine->x < point.x && lineInfo.location == LocationRelativeToLine::UnderOrRight)
-                return true;
-            if (verticalLine->x > point.x && lineInfo.location == LocationRelativeToLine::AboveOrLeft)
-                return true;
+        const long long sign = convexTurn == Orientation::CounterClockwise ? 1 : -1;
+        const std::vector<Point>& chains = convexTurn == Orientation::CounterClockwise ? groupChains.lowerChains : groupChains.upperChains;
+        const std::vector<size_t>& chainEnds = convexTurn == Orientation::CounterClockwise ? groupChains.lowerChainEnds : groupChains.upperChainEnds;
+
+        chain.assign (1, firstPoint);
+        while (chain.back () != lastPoint) {
+            if (chain.size () == maxCornerCount)
+                return false;
+
+            GEOMETRY_COUNT (wrapIterationCount, 1);
+            GEOMETRY_COUNT (examinedPointCount, chainEnds.size ());
+            const Point currentPoint = chain.back ();
+            std::optional<Point> nextPoint;
+            size_t chainBegin = 0;
+            for (size_t chainEnd : chainEnds) {
+                const size_t firstIndex = std::upper_bound (chains.begin () + chainBegin, chains.begin () + chainEnd, currentPoint, PointComparator ()) - chains.begin ();
+                chainBegin = chainEnd;
+                if (firstIndex == chainEnd)
+                    continue;
+
+                const size_t tangentIndex = FindTangentIndexInChain (currentPoint, firstIndex, chainEnd - 1,
+                                                                     [&chains] (size_t index) { return chains[index]; }, convexTurn);
+                const Point& candidatePoint = chains[tangentIndex];
+                if (!nextPoint.has_value ()) {
+                    nextPoint = candidatePoint;
+                    continue;
+                }
+
+                // the candidate is better if it is on the outer side of the current best line, or farther on the same line
+                const WideInteger crossProduct = sign * CrossProduct (currentPoint, *nextPoint, candidatePoint);
+                if (crossProduct < 0 || (crossProduct == 0 && PointComparator () (*nextPoint, candidatePoint)))
+                    nextPoint = candidatePoint;
+            }
+            chain.push_back (*nextPoint);
         }
-        return false;
+        return true;
     }
 
 
-    static bool CheckIfPointIsInPolygon (const std::vector<LineAndLocation>& lines, const Point& point)
+    // Chan's algorithm: the points are split into groups of m points, and the polygon of every group is calculated
+    // the lower and the upper chain are wrapped over the groups, with at most m corners each
+    // if this is not enough, m is squared and everything is repeated, so the running time is O(n log h)
+    template <typename PointContainer>
+    static std::vector<Point> CalculateBoundingPolygonWithChan (const PointContainer& points)
     {
-        for (const LineAndLocation& lineInfo : lines) {
-            if (!CheckIfPointIsOnTheCorrectSide (lineInfo, point))
-                return false;
+        std::vector<Point> groupedPoints (points.begin (), points.end ());
+        const Point firstPoint = *std::min_element (groupedPoints.begin (), groupedPoints.end (), PointComparator ());
+        const Point lastPoint = *std::max_element (groupedPoints.begin (), groupedPoints.end (), PointComparator ());
+        GEOMETRY_START_PHASE (Search);
+
+        std::vector<Point> lowerChain;
+        std::vector<Point> upperChain;
+        for (size_t groupSize = 4; ; groupSize = groupSize < groupedPoints.size () / groupSize ? groupSize * groupSize : groupedPoints.size ()) {
+            GroupChains groupChains;
+            for (size_t groupBegin = 0; groupBegin < groupedPoints.size (); groupBegin += groupSize) {
+                const size_t groupEnd = std::min (groupBegin + groupSize, groupedPoints.size ());
+                AddGroupChains (groupChains, groupedPoints.begin () + groupBegin, groupedPoints.begin () + groupEnd);
+            }
+
+            if (WrapGroupChains (groupChains, firstPoint, lastPoint, Orientation::CounterClockwise, groupSize + 1, lowerChain) &&
+                WrapGroupChains (groupChains, firstPoint, lastPoint, Orientation::Clockwise, groupSize + 1, upperChain))
+                break;
         }
-        return true;
+
+        // the first and the last points are in both chains
+        std::vector<Point> boundingPoints (lowerChain);
+        boundingPoints.insert (boundingPoints.end (), std::next (upperChain.rbegin ()), std::prev (upperChain.rend ()));
+        return boundingPoints;
     }
 
 
-    bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, const PointSet& points)
+    // the corners of the polygon in the order of PointComparator
+    // the lower chain (up to the rightmost corner) is already sorted, the upper chain is sorted in reverse order
+    static std::vector<Point> SortPolygonPoints (const Polygon& polygon)
     {
-        assert (polygon.size () > 2);
+        std::vector<Point> sortedPoints;
+        if (polygon.empty ())
+            return sortedPoints;
+
+        sortedPoints.reserve (polygon.size ());
+        const auto rightMostPoint = std::max_element (polygon.begin (), polygon.end (), PointComparator ());
+        std::merge (polygon.begin (), std::next (rightMostPoint),
+                    polygon.rbegin (), std::make_reverse_iterator (std::next (rightMostPoint)),
+                    std::back_inserter (sortedPoints), PointComparator ());
+        return sortedPoints;
+    }
 
-        std::vector<LineAndLocation> lines = PolygonPointsToLines (polygon);
-        for (const Point& point : points) {
-            if (!CheckIfPointIsInPolygon (lines, point))
-                return false;
+
+    // sorts the points of one part in place, and returns the corners of their polygon sorted
+    static void CalculatePartialPolygon (Point* points, size_t pointCount, std::vector<Point>& sortedPolygonPoints)
+    {
+        std::sort (points, points + pointCount, PointComparator ());
+        sortedPolygonPoints = SortPolygonPoints (CalculateMonotoneChainOfSortedPoints (PointSpan (points, pointCount)));
+    }
+
+
+    // the points are split into equal index ranges between the threads, every thread calculates the polygon of its own range
+    // the corners of the partial polygons are merged in sorted order, and the final polygon is built from them in linear time
+    // the result is the same as the result of the sequential algorithms
+    static std::vector<Point> CalculateBoundingPolygonOfArrayInParallel (PointArray& points, unsigned int threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max (std::thread::hardware_concurrency (), 1u);
+        const size_t partCount = std::min<size_t> (threadCount, points.size ());
+
+        std::vector<std::vector<Point>> sortedPolygonPoints (partCount);
+        std::vector<std::thread> workers;
+        for (size_t part = 1; part < partCount; part++) {
+            const size_t firstIndex = points.size () * part / partCount;
+            const size_t lastIndex = points.size () * (part + 1) / partCount;
+            workers.emplace_back (CalculatePartialPolygon, points.data () + firstIndex, lastIndex - firstIndex, std::ref (sortedPolygonPoints[part]));
+        }
+        CalculatePartialPolygon (points.data (), points.size () / partCount, sortedPolygonPoints[0]);
+        for (std::thread& worker : workers)
+            worker.join ();
+
+        while (sortedPolygonPoints.size () > 1) {
+            std::vector<std::vector<Point>> mergedPolygonPoints ((sortedPolygonPoints.size () + 1) / 2);
+            for (size_t index = 0; index + 1 < sortedPolygonPoints.size (); index += 2) {
+                const std::vector<Point>& points1 = sortedPolygonPoints[index];
+                const std::vector<Point>& points2 = sortedPolygonPoints[index + 1];
+                std::vector<Point>& mergedPoints = mergedPolygonPoints[index / 2];
+                mergedPoints.reserve (points1.size () + points2.size ());
+                std::merge (points1.begin (), points1.end (), points2.begin (), points2.end (),
+                            std::back_inserter (mergedPoints), PointComparator ());
+            }
+            if (sortedPolygonPoints.size () % 2 == 1)
+                mergedPolygonPoints.back () = std::move (sortedPolygonPoints.back ());
+            sortedPolygonPoints = std::move (mergedPolygonPoints);
         }
 
-        return true;
+        return CalculateMonotoneChainOfSortedPoints (sortedPolygonPoints[0]);
+    }
+
+
+    // the points are copied into one array in one pass over the set, so the parts are contiguous and have the same size
+    std::vector<Point> CalculateBoundingPolygonInParallel (const PointSet& points, unsigned int threadCount)
+    {
+        assert (points.size () > 2);
+        assert (!Geometry::AreAllPointsInOneLine (points));
+
+        PointArray pointArray;
+        pointArray.reserve (points.size ());
+        for (const Point& point : points)
+            pointArray.push_back (point);
+        return CalculateBoundingPolygonOfArrayInParallel (pointArray, threadCount);
+    }
+
+
+    std::vector<Point> CalculateBoundingPolygonInParallel (PointSpan points, unsigned int threadCount)
+    {
+        assert (points.size > 2);
+        assert (!Geometry::AreAllPointsInOneLine (points));
+
+        PointArray pointArray (points.begin (), points.end ());
+        return CalculateBoundingPolygonOfArrayInParallel (pointArray, threadCount);
+    }
+
+
+    // above this many points the two halves of a quickhull step are calculated as separate tasks
+    static const size_t QuickHullTaskThreshold = 4096;
+    // above this many points the points of a quickhull step are partitioned in chunks of this size in parallel
+    static const size_t QuickHullChunkSize = 32768;
+
+
+    // the points strictly on the right side of a directed line, and the farthest one of them
+    // if multiple points are the farthest, they are on one line parallel to the directed line, and the smallest one is chosen
+    struct OuterPoints
+    {
+        std::vector<Point> points;
+        Point farthestPoint;
+        WideInteger farthestCrossProduct = 0;
+    };
+
+
+    static void UpdateFarthestPoint (OuterPoints& outerPoints, const Point& point, const WideInteger& crossProduct)
+    {
+        if (crossProduct < outerPoints.farthestCrossProduct ||
+            (crossProduct == outerPoints.farthestCrossProduct && PointComparator () (point, outerPoints.farthestPoint)))
+        {
+            outerPoints.farthestPoint = point;
+            outerPoints.farthestCrossProduct = crossProduct;
+        }
+    }
+
+
+    // the points on the right side of lineStart-splitPoint go to firstOuterPoints, the ones on the right side of splitPoint-lineEnd to secondOuterPoints
+    // splitPoint is the farthest point from the line lineStart-lineEnd, so no point is on the right side of both lines
+    static void PartitionPoints (const Point* pointsBegin, const Point* pointsEnd, const Point& lineStart, const Point& splitPoint, const Point& lineEnd,
+                                 OuterPoints& firstOuterPoints, OuterPoints& secondOuterPoints)
+    {
+        GEOMETRY_COUNT (examinedPointCount, pointsEnd - pointsBegin);
+        for (const Point* point = pointsBegin; point != pointsEnd; point++) {
+            const WideInteger firstCrossProduct = CrossProduct (lineStart, splitPoint, *point);
+            if (firstCrossProduct < 0) {
+                firstOuterPoints.points.push_back (*point);
+                UpdateFarthestPoint (firstOuterPoints, *point, firstCrossProduct);
+                continue;
+            }
+
+            const WideInteger secondCrossProduct = CrossProduct (splitPoint, lineEnd, *point);
+            if (secondCrossProduct < 0) {
+                secondOuterPoints.points.push_back (*point);
+                UpdateFarthestPoint (secondOuterPoints, *point, secondCrossProduct);
+            }
+        }
+    }
+
+
+    static void MergeOuterPoints (OuterPoints& outerPoints, const OuterPoints& otherOuterPoints)
+    {
+        outerPoints.points.insert (outerPoints.points.end (), otherOuterPoints.points.begin (), otherOuterPoints.points.end ());
+        if (!otherOuterPoints.points.empty ())
+            UpdateFarthestPoint (outerPoints, otherOuterPoints.farthestPoint, otherOuterPoints.farthestCrossProduct);
+    }
+
+
+    // with a pool, big point sets are split into chunks, and every chunk is partitioned by a separate task
+    static void PartitionPointsInChunks (Parallel::WorkStealingPool* pool, const std::vector<Point>& points, const Point& lineStart, const Point& splitPoint,
+                                         const Point& lineEnd, OuterPoints& firstOuterPoints, OuterPoints& secondOuterPoints)
+    {
+        if (pool == nullptr || points.size () < 2 * QuickHullChunkSize) {
+            PartitionPoints (points.data (), points.data () + points.size (), lineStart, splitPoint, lineEnd, firstOuterPoints, secondOuterPoints);
+            return;
+        }
+
+        const size_t chunkCount = (points.size () + QuickHullChunkSize - 1) / QuickHullChunkSize;
+        std::vector<OuterPoints> chunkOuterPoints (2 * chunkCount);
+        {
+            Parallel::TaskGroup taskGroup (*pool);
+            for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+                taskGroup.Run ([&, chunk] {
+                    const Point* chunkBegin = points.data () + chunk * QuickHullChunkSize;
+                    const Point* chunkEnd = points.data () + std::min (points.size (), (chunk + 1) * QuickHullChunkSize);
+                    PartitionPoints (chunkBegin, chunkEnd, lineStart, splitPoint, lineEnd, chunkOuterPoints[2 * chunk], chunkOuterPoints[2 * chunk + 1]);
+                });
+            }
+        }
+
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+            MergeOuterPoints (firstOuterPoints, chunkOuterPoints[2 * chunk]);
+            MergeOuterPoints (secondOuterPoints, chunkOuterPoints[2 * chunk + 1]);
+        }
+    }
+
+
+    // the corners between the endpoints of a line, found by one quickhull step
+    // if there are no outer points, the node is not split and has no corners
+    struct QuickHullNode
+    {
+        Point splitPoint;
+        std::unique_ptr<QuickHullNode> firstNode;
+        std::unique_ptr<QuickHullNode> secondNode;
+    };
+
+
+    // the split point of the outer points of lineStart-lineEnd is a corner, the outer points of the two new lines are processed recursively
+    static void FindCornersOnRightSide (Parallel::WorkStealingPool* pool, const Point& lineStart, const Point& lineEnd, OuterPoints outerPoints, QuickHullNode& node)
+    {
+        if (outerPoints.points.empty ())
+            return;
+
+        node.splitPoint = outerPoints.farthestPoint;
+        node.firstNode = std::make_unique<QuickHullNode> ();
+        node.secondNode = std::make_unique<QuickHullNode> ();
+
+        OuterPoints firstOuterPoints;
+        OuterPoints secondOuterPoints;
+        PartitionPointsInChunks (pool, outerPoints.points, lineStart, node.splitPoint, lineEnd, firstOuterPoints, secondOuterPoints);
+        outerPoints = OuterPoints ();
+
+        if (pool == nullptr || firstOuterPoints.points.size () + secondOuterPoints.points.size () < QuickHullTaskThreshold) {
+            FindCornersOnRightSide (pool, lineStart, node.splitPoint, std::move (firstOuterPoints), *node.firstNode);
+            FindCornersOnRightSide (pool, node.splitPoint, lineEnd, std::move (secondOuterPoints), *node.secondNode);
+            return;
+        }
+
+        Parallel::TaskGroup taskGroup (*pool);
+        taskGroup.Run ([&] {
+            FindCornersOnRightSide (pool, lineStart, node.splitPoint, std::move (firstOuterPoints), *node.firstNode);
+        });
+        FindCornersOnRightSide (pool, node.splitPoint, lineEnd, std::move (secondOuterPoints), *node.secondNode);
+        taskGroup.Wait ();
+    }
+
+
+    static void AppendCornersOfNode (const QuickHullNode& node, std::vector<Point>& boundingPoints)
+    {
+        if (node.firstNode == nullptr)
+            return;
+
+        AppendCornersOfNode (*node.firstNode, boundingPoints);
+        boundingPoints.push_back (node.splitPoint);
+        AppendCornersOfNode (*node.secondNode, boundingPoints);
+    }
+
+
+    // quickhull: the leftmost and the rightmost points split the points into a lower and an upper part
+    // in every step the farthest point from the line is a corner, and the points outside of the two new lines are processed further
+    // without a pool everything runs on the calling thread
+    static std::vector<Point> CalculateBoundingPolygonWithQuickHull (Parallel::WorkStealingPool* pool, PointSpan points)
+    {
+        const Point leftMostPoint = *std::min_element (points.begin (), points.end (), PointComparator ());
+        const Point rightMostPoint = *std::max_element (points.begin (), points.end (), PointComparator ());
+        const std::vector<Point> allPoints (points.begin (), points.end ());
+        GEOMETRY_START_PHASE (Search);
+
+        OuterPoints lowerPoints;
+        OuterPoints upperPoints;
+        PartitionPointsInChunks (pool, allPoints, leftMostPoint, rightMostPoint, leftMostPoint, lowerPoints, upperPoints);
+
+        QuickHullNode lowerNode;
+        QuickHullNode upperNode;
+        if (pool == nullptr) {
+            FindCornersOnRightSide (pool, leftMostPoint, rightMostPoint, std::move (lowerPoints), lowerNode);
+            FindCornersOnRightSide (pool, rightMostPoint, leftMostPoint, std::move (upperPoints), upperNode);
+        } else {
+            Parallel::TaskGroup taskGroup (*pool);
+            taskGroup.Run ([&] {
+                FindCornersOnRightSide (pool, leftMostPoint, rightMostPoint, std::move (lowerPoints), lowerNode);
+            });
+            FindCornersOnRightSide (pool, rightMostPoint, leftMostPoint, std::move (upperPoints), upperNode);
+            taskGroup.Wait ();
+        }
+
+        std::vector<Point> boundingPoints = {leftMostPoint};
+        AppendCornersOfNode (lowerNode, boundingPoints);
+        boundingPoints.push_back (rightMostPoint);
+        AppendCornersOfNode (upperNode, boundingPoints);
+        return boundingPoints;
+    }
+
+
+    // the steps of quickhull run as tasks on the pool, the calling thread also takes part in the work
+    std::vector<Point> CalculateBoundingPolygonWithQuickHull (PointSpan points, Parallel::WorkStealingPool& pool)
+    {
+        assert (points.size > 2);
+        assert (!Geometry::AreAllPointsInOneLine (points));
+
+        return CalculateBoundingPolygonWithQuickHull (&pool, points);
+    }
+
+
+    // threadCount includes the calling thread, 0 means one thread per hardware thread
+    std::vector<Point> CalculateBoundingPolygonWithQuickHull (PointSpan points, unsigned int threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max (std::thread::hardware_concurrency (), 1u);
+
+        Parallel::WorkStealingPool pool (threadCount - 1);
+        return CalculateBoundingPolygonWithQuickHull (points, pool);
+    }
+
+
+    std::vector<Point> CalculateBoundingPolygon (const PointSet& points, BoundingPolygonAlgorithm algorithm)
+    {
+        GEOMETRY_START_STATISTICS (Validation);
+        assert (points.size () > 2);
+        assert (!Geometry::AreAllPointsInOneLine (points));
+
+        GEOMETRY_START_PHASE (Preprocessing);
+        std::vector<Point> boundingPoints;
+        switch (algorithm) {
+            case BoundingPolygonAlgorithm::MonotoneChain:
+                boundingPoints = CalculateBoundingPolygonWithMonotoneChain (points);
+                break;
+            case BoundingPolygonAlgorithm::Chan:
+                boundingPoints = CalculateBoundingPolygonWithChan (points);
+                break;
+            case BoundingPolygonAlgorithm::QuickHull:
+                boundingPoints = CalculateBoundingPolygonWithQuickHull (nullptr, PointArray (points.begin (), points.end ()));
+                break;
+            case BoundingPolygonAlgorithm::GiftWrapping:
+            default:
+                boundingPoints = CalculateBoundingPolygonWithGiftWrapping (points);
+                break;
+        }
+        GEOMETRY_FINISH_STATISTICS ();
+        return boundingPoints;
+    }
+
+
+    std::vector<Point> CalculateBoundingPolygon (PointSpan points, BoundingPolygonAlgorithm algorithm)
+    {
+        GEOMETRY_START_STATISTICS (Validation);
+        assert (points.size > 2);
+        assert (!Geometry::AreAllPointsInOneLine (points));
+
+        GEOMETRY_START_PHASE (Preprocessing);
+        std::vector<Point> boundingPoints;
+        switch (algorithm) {
+            case BoundingPolygonAlgorithm::MonotoneChain:
+                boundingPoints = CalculateBoundingPolygonWithMonotoneChain (points);
+                break;
+            case BoundingPolygonAlgorithm::Chan:
+                boundingPoints = CalculateBoundingPolygonWithChan (points);
+                break;
+            case BoundingPolygonAlgorithm::QuickHull:
+                boundingPoints = CalculateBoundingPolygonWithQuickHull (nullptr, points);
+                break;
+            case BoundingPolygonAlgorithm::GiftWrapping:
+            default:
+                boundingPoints = CalculateBoundingPolygonWithGiftWrapping (points);
+                break;
+        }
+        GEOMETRY_FINISH_STATISTICS ();
+        return boundingPoints;
+    }
+
+
+    static PointArray ReadAllPoints (const PointSource& points)
+    {
+        PointArray allPoints;
+        allPoints.reserve (points.GetPointCount ());
+        points.VisitPoints ([&allPoints] (PointSpan chunk) {
+            allPoints.insert (allPoints.end (), chunk.begin (), chunk.end ());
+        });
+        return allPoints;
+    }
+
+
+    // gift wrapping reads the points of the source in every step without copying them
+    // the other algorithms need the points in one array, they read them into their working array once
+    std::vector<Point> CalculateBoundingPolygon (const PointSource& points, BoundingPolygonAlgorithm algorithm)
+    {
+        GEOMETRY_START_STATISTICS (Validation);
+        assert (points.GetPointCount () > 2);
+        assert (!Geometry::AreAllPointsInOneLine (points));
+
+        GEOMETRY_START_PHASE (Preprocessing);
+        std::vector<Point> boundingPoints;
+        switch (algorithm) {
+            case BoundingPolygonAlgorithm::MonotoneChain: {
+                PointArray allPoints = ReadAllPoints (points);
+                boundingPoints = CalculateBoundingPolygonWithMonotoneChainInPlace (allPoints);
+                break;
+            }
+            case BoundingPolygonAlgorithm::Chan:
+                boundingPoints = CalculateBoundingPolygonWithChan (ReadAllPoints (points));
+                break;
+            case BoundingPolygonAlgorithm::QuickHull:
+                boundingPoints = CalculateBoundingPolygonWithQuickHull (nullptr, ReadAllPoints (points));
+                break;
+            case BoundingPolygonAlgorithm::GiftWrapping:
+            default:
+                boundingPoints = CalculateBoundingPolygonWithGiftWrapping (points);
+                break;
+        }
+        GEOMETRY_FINISH_STATISTICS ();
+        return boundingPoints;
+    }
+
+
+    // the points that are extreme in the directions -x, -x-y, -y, x-y, x, x+y, y, y-x in this order
+    template <typename PointContainer>
+    static Polygon FindExtremePointsInEightDirections (const PointContainer& points)
+    {
+        assert (points.begin () != points.end ());
+
+        const Point& firstPoint = *points.begin ();
+        Polygon extremePoints (8, firstPoint);
+        long long minSum = (long long)firstPoint.x + firstPoint.y;
+        long long maxSum = minSum;
+        long long minDifference = (long long)firstPoint.x - firstPoint.y;
+        long long maxDifference = minDifference;
+
+        for (const Point& point : points) {
+            const long long sum = (long long)point.x + point.y;
+            const long long difference = (long long)point.x - point.y;
+            if (point.x < extremePoints[0].x)
+                extremePoints[0] = point;
+            if (sum < minSum) {
+                minSum = sum;
+                extremePoints[1] = point;
+            }
+            if (point.y < extremePoints[2].y)
+                extremePoints[2] = point;
+            if (difference > maxDifference) {
+                maxDifference = difference;
+                extremePoints[3] = point;
+            }
+            if (point.x > extremePoints[4].x)
+                extremePoints[4] = point;
+            if (sum > maxSum) {
+                maxSum = sum;
+                extremePoints[5] = point;
+            }
+            if (point.y > extremePoints[6].y)
+                extremePoints[6] = point;
+            if (difference < minDifference) {
+                minDifference = difference;
+                extremePoints[7] = point;
+            }
+        }
+
+        // the same point can be extreme in several directions
+        extremePoints.erase (std::unique (extremePoints.begin (), extremePoints.end ()), extremePoints.end ());
+        while (extremePoints.size () > 1 && extremePoints.front () == extremePoints.back ())
+            extremePoints.pop_back ();
+        return extremePoints;
+    }
+
+
+    // the point is tested against every edge without an early exit, so the loop has no branch that depends on the point
+    static bool IsPointStrictlyInsidePolygon (const Polygon& polygon, const Point& point)
+    {
+        bool isInside = true;
+        for (size_t index = 0; index < polygon.size (); index++) {
+            const Point& edgeStart = polygon[index];
+            const Point& edgeEnd = polygon[index + 1 == polygon.size () ? 0 : index + 1];
+            isInside &= CrossProduct (edgeStart, edgeEnd, point) > 0;
+        }
+        return isInside;
+    }
+
+
+    // Akl-Toussaint heuristic: the points strictly inside the polygon of the extreme points cannot be corners of the bounding polygon
+    CulledPointSet CullInteriorPoints (const PointSet& points)
+    {
+        if (points.size () < 4)
+            return {points, 0};
+
+        const Polygon extremePoints = FindExtremePointsInEightDirections (points);
+        if (extremePoints.size () < 3)
+            return {points, 0};
+
+        CulledPointSet result {PointSet (), 0};
+        for (const Point& point : points) {
+            if (IsPointStrictlyInsidePolygon (extremePoints, point))
+                result.culledPointCount++;
+            else
+                result.points.insert (point);
+        }
+        return result;
+    }
+
+
+    // every point is written to the next free place, and the place is only kept if the point is not culled,
+    // so the order of the remaining points is kept and the copy does not branch on the result of the test
+    CulledPointArray CullInteriorPoints (PointSpan points)
+    {
+        if (points.size < 4)
+            return {PointArray (points.begin (), points.end ()), 0};
+
+        const Polygon extremePoints = FindExtremePointsInEightDirections (points);
+        if (extremePoints.size () < 3)
+            return {PointArray (points.begin (), points.end ()), 0};
+
+        CulledPointArray result {PointArray (points.size), 0};
+        size_t keptPointCount = 0;
+        for (const Point& point : points) {
+            result.points[keptPointCount] = point;
+            keptPointCount += !IsPointStrictlyInsidePolygon (extremePoints, point);
+        }
+        result.points.resize (keptPointCount);
+        result.culledPointCount = points.size - keptPointCount;
+        return result;
+    }
+
+
+    ConvexPolygonQuery::ConvexPolygonQuery (const Polygon& polygon) :
+        polygon (polygon),
+        bounds (CalculatePointBounds (polygon.data (), polygon.size ()))
+    {
+        assert (polygon.size () > 2);
+
+        if (GetOrientation (polygon[0], polygon[1], polygon[2]) == Orientation::Clockwise)
+            std::reverse (this->polygon.begin () + 1, this->polygon.end ());
+    }
+
+
+    // the point is on the line of the segment, check if it is between the endpoints
+    static bool IsCollinearPointOnSegment (const Point& segmentStart, const Point& segmentEnd, const Point& point)
+    {
+        const long long xDifference = (long long)segmentEnd.x - segmentStart.x;
+        const long long yDifference = (long long)segmentEnd.y - segmentStart.y;
+        const WideInteger dotProduct = Multiply ((long long)point.x - segmentStart.x, xDifference) + Multiply ((long long)point.y - segmentStart.y, yDifference);
+        return dotProduct >= 0 && dotProduct <= Multiply (xDifference, xDifference) + Multiply (yDifference, yDifference);
+    }
+
+
+    static PointLocation GetLocationForEdgeCrossProduct (const WideInteger& edgeCrossProduct)
+    {
+        if (edgeCrossProduct > 0)
+            return PointLocation::Inside;
+        if (edgeCrossProduct == 0)
+            return PointLocation::OnBoundary;
+        return PointLocation::Outside;
+    }
+
+
+    // points on the edges are inside the polygon
+    bool ConvexPolygonQuery::Contains (const Point& point) const
+    {
+        return Locate (point) != PointLocation::Outside;
+    }
+
+
+    PointLocation ConvexPolygonQuery::Locate (const Point& point) const
+    {
+        const Point& pivot = polygon.front ();
+        const WideInteger firstEdgeCrossProduct = CrossProduct (pivot, polygon[1], point);
+        const WideInteger lastEdgeCrossProduct = CrossProduct (pivot, polygon.back (), point);
+        if (firstEdgeCrossProduct < 0 || lastEdgeCrossProduct > 0)
+            return PointLocation::Outside;
+        if (firstEdgeCrossProduct == 0)
+            return IsCollinearPointOnSegment (pivot, polygon[1], point) ? PointLocation::OnBoundary : PointLocation::Outside;
+        if (lastEdgeCrossProduct == 0)
+            return IsCollinearPointOnSegment (pivot, polygon.back (), point) ? PointLocation::OnBoundary : PointLocation::Outside;
+
+        // the last corner that is not to the left of the point, seen from the pivot
+        size_t lowerIndex = 1;
+        size_t upperIndex = polygon.size () - 2;
+        while (lowerIndex < upperIndex) {
+            const size_t middleIndex = (lowerIndex + upperIndex + 1) / 2;
+            if (CrossProduct (pivot, polygon[middleIndex], point) >= 0)
+                lowerIndex = middleIndex;
+            else
+                upperIndex = middleIndex - 1;
+        }
+        return GetLocationForEdgeCrossProduct (CrossProduct (polygon[lowerIndex], polygon[lowerIndex + 1], point));
+    }
+
+
+#if defined (GEOMETRY_X86)
+    // every 64-bit lane contains the x and y coords of a point (or the coord differences of two points) as two ints
+    // _mm256_mul_epi32 multiplies the lower 32 bits of the lanes, so the products are exact 64-bit values
+    GEOMETRY_TARGET ("avx2")
+    static __m256i CrossProductOfDifferences (__m256i differences1, __m256i differences2)
+    {
+        return _mm256_sub_epi64 (_mm256_mul_epi32 (differences1, _mm256_srli_epi64 (differences2, 32)),
+                                 _mm256_mul_epi32 (_mm256_srli_epi64 (differences1, 32), differences2));
+    }
+
+
+    GEOMETRY_TARGET ("avx2")
+    static int GetLaneSigns (__m256i mask)
+    {
+        return _mm256_movemask_pd (_mm256_castsi256_pd (mask));
+    }
+
+
+    // locates four points at once, every step of the binary search gathers the corners of the four lanes
+    // all of the coord differences have to fit into an int
+    GEOMETRY_TARGET ("avx2")
+    static void LocateFourPoints (const Polygon& polygon, const Point* points, PointLocation* locations, const ConvexPolygonQuery& polygonQuery)
+    {
+        const long long* corners = reinterpret_cast<const long long*> (polygon.data ());
+        const __m256i pointCoords = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (points));
+        const __m256i pivotCoords = _mm256_set1_epi64x (corners[0]);
+        const __m256i pointDifferences = _mm256_sub_epi32 (pointCoords, pivotCoords);
+        const __m256i zero = _mm256_setzero_si256 ();
+
+        const __m256i firstEdgeDifferences = _mm256_sub_epi32 (_mm256_set1_epi64x (corners[1]), pivotCoords);
+        const __m256i lastEdgeDifferences = _mm256_sub_epi32 (_mm256_set1_epi64x (corners[polygon.size () - 1]), pivotCoords);
+        const __m256i firstEdgeCrossProduct = CrossProductOfDifferences (firstEdgeDifferences, pointDifferences);
+        const __m256i lastEdgeCrossProduct = CrossProductOfDifferences (lastEdgeDifferences, pointDifferences);
+
+        __m256i lowerIndex = _mm256_set1_epi64x (1);
+        size_t candidateCount = polygon.size () - 2;
+        while (candidateCount > 1) {
+            const size_t half = candidateCount / 2;
+            const __m256i middleIndex = _mm256_add_epi64 (lowerIndex, _mm256_set1_epi64x ((long long)half));
+            const __m256i cornerDifferences = _mm256_sub_epi32 (_mm256_i64gather_epi64 (corners, middleIndex, 8), pivotCoords);
+            const __m256i isNotLeft = _mm256_cmpgt_epi64 (CrossProductOfDifferences (cornerDifferences, pointDifferences), _mm256_set1_epi64x (-1));
+            lowerIndex = _mm256_blendv_epi8 (lowerIndex, middleIndex, isNotLeft);
+            candidateCount -= half;
+        }
+
+        const __m256i edgeStart = _mm256_i64gather_epi64 (corners, lowerIndex, 8);
+        const __m256i edgeEnd = _mm256_i64gather_epi64 (corners, _mm256_add_epi64 (lowerIndex, _mm256_set1_epi64x (1)), 8);
+        const __m256i edgeCrossProduct = CrossProductOfDifferences (_mm256_sub_epi32 (edgeEnd, edgeStart), _mm256_sub_epi32 (pointCoords, edgeStart));
+
+        const int outsideLanes = GetLaneSigns (_mm256_cmpgt_epi64 (zero, firstEdgeCrossProduct)) | GetLaneSigns (_mm256_cmpgt_epi64 (lastEdgeCrossProduct, zero));
+        const int pivotEdgeLanes = GetLaneSigns (_mm256_cmpeq_epi64 (firstEdgeCrossProduct, zero)) | GetLaneSigns (_mm256_cmpeq_epi64 (lastEdgeCrossProduct, zero));
+        const int insideLanes = GetLaneSigns (_mm256_cmpgt_epi64 (edgeCrossProduct, zero));
+        const int boundaryLanes = GetLaneSigns (_mm256_cmpeq_epi64 (edgeCrossProduct, zero));
+
+        for (int lane = 0; lane < 4; lane++) {
+            const int laneBit = 1 << lane;
+            if (outsideLanes & laneBit)
+                locations[lane] = PointLocation::Outside;
+            else if (pivotEdgeLanes & laneBit)
+                locations[lane] = polygonQuery.Locate (points[lane]);
+            else if (insideLanes & laneBit)
+                locations[lane] = PointLocation::Inside;
+            else if (boundaryLanes & laneBit)
+                locations[lane] = PointLocation::OnBoundary;
+            else
+                locations[lane] = PointLocation::Outside;
+        }
+    }
+
+
+    static bool DoCoordDifferencesFitIntoInt (const PointBounds& bounds1, const PointBounds& bounds2)
+    {
+        const long long maxDifference = std::numeric_limits<int>::max ();
+        return (long long)std::max (bounds1.maxXCoord, bounds2.maxXCoord) - std::min (bounds1.minXCoord, bounds2.minXCoord) <= maxDifference &&
+               (long long)std::max (bounds1.maxYCoord, bounds2.maxYCoord) - std::min (bounds1.minYCoord, bounds2.minYCoord) <= maxDifference;
+    }
+#endif
+
+
+    // if the CPU supports AVX2, four points are located at once if the coords are close enough to each other
+    void ConvexPolygonQuery::LocatePoints (PointSpan points, PointLocation* locations) const
+    {
+        if (points.size == 0)
+            return;
+
+        size_t index = 0;
+#if defined (GEOMETRY_X86)
+        if (GetVectorInstructionSet () == VectorInstructionSet::AVX2 && DoCoordDifferencesFitIntoInt (bounds, CalculatePointBounds (points.data, points.size))) {
+            for (; index + 4 <= points.size; index += 4)
+                LocateFourPoints (polygon, points.data + index, locations + index, *this);
+        }
+#endif
+        for (; index < points.size; index++)
+            locations[index] = Locate (points.data[index]);
+    }
+
+
+    // the points are split into equal parts between the threads
+    void ClassifyPoints (const ConvexPolygonQuery& polygonQuery, PointSpan points, PointLocation* locations, unsigned int threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max (std::thread::hardware_concurrency (), 1u);
+        const size_t partCount = std::max<size_t> (std::min<size_t> (threadCount, points.size), 1);
+
+        std::vector<std::thread> workers;
+        for (size_t part = 1; part < partCount; part++) {
+            const size_t firstIndex = points.size * part / partCount;
+            const size_t lastIndex = points.size * (part + 1) / partCount;
+            workers.emplace_back ([&polygonQuery, points, locations, firstIndex, lastIndex] () {
+                polygonQuery.LocatePoints (PointSpan (points.data + firstIndex, lastIndex - firstIndex), locations + firstIndex);
+            });
+        }
+        polygonQuery.LocatePoints (PointSpan (points.data, points.size / partCount), locations);
+        for (std::thread& worker : workers)
+            worker.join ();
+    }
+
+
+    template <typename PointContainer>
+    static bool CheckIfPolygonContainsAllPointsInContainer (const std::vector<Point>& polygon, const PointContainer& points)
+    {
+        assert (polygon.size () > 2);
+
+        const ConvexPolygonQuery polygonQuery (polygon);
+        bool containsAllPoints = true;
+        ForEachPoint (points, [&] (const Point& point) {
+            if (containsAllPoints && !polygonQuery.Contains (point))
+                containsAllPoints = false;
+        });
+        return containsAllPoints;
+    }
+
+
+    bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, const PointSet& points)
+    {
+        return CheckIfPolygonContainsAllPointsInContainer (polygon, points);
+    }
+
+
+    bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, PointSpan points)
+    {
+        return CheckIfPolygonContainsAllPointsInContainer (polygon, points);
+    }
+
+
+    bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, const PointSource& points)
+    {
+        return CheckIfPolygonContainsAllPointsInContainer (polygon, points);
+    }
+
+
+    // the points outside of the current polygon are merged with its corners in sorted order, and the new polygon is built from them
+    // the corners of the result are the same as if all of the points were processed at once
+    void StreamingBoundingPolygon::AddPoints (PointSpan points)
+    {
+        std::vector<Point> newPoints;
+        if (polygon.size () > 2) {
+            pointLocations.resize (points.size);
+            ConvexPolygonQuery (polygon).LocatePoints (points, pointLocations.data ());
+            for (size_t index = 0; index < points.size; index++) {
+                if (pointLocations[index] == PointLocation::Outside)
+                    newPoints.push_back (points.data[index]);
+            }
+        } else {
+            newPoints.assign (points.begin (), points.end ());
+        }
+        if (newPoints.empty ())
+            return;
+
+        std::sort (newPoints.begin (), newPoints.end (), PointComparator ());
+        const std::vector<Point> sortedCorners = SortPolygonPoints (polygon);
+        std::vector<Point> sortedPoints;
+        sortedPoints.reserve (sortedCorners.size () + newPoints.size ());
+        std::merge (sortedCorners.begin (), sortedCorners.end (), newPoints.begin (), newPoints.end (),
+                    std::back_inserter (sortedPoints), PointComparator ());
+        sortedPoints.erase (std::unique (sortedPoints.begin (), sortedPoints.end ()), sortedPoints.end ());
+
+        polygon = CalculateMonotoneChainOfSortedPoints (sortedPoints);
+    }
+
+
+    void StreamingBoundingPolygon::Clear ()
+    {
+        polygon.clear ();
+        pointLocations.clear ();
+    }
+
+
+    // false if there are less than 3 points, or all of the points are in one line
+    bool StreamingBoundingPolygon::IsValidPolygon () const
+    {
+        return polygon.size () > 2;
+    }
+
+
+    // same order as CalculateBoundingPolygon: counter-clockwise, starting with the leftmost point
+    Polygon StreamingBoundingPolygon::GetPolygon () const
+    {
+        return polygon;
+    }
+
+
+    // only one chunk of points is in the memory at once
+    Polygon CalculateBoundingPolygonOfStream (const PointStreamReader& readPoints, size_t chunkSize)
+    {
+        assert (chunkSize > 0);
+
+        std::vector<Point> chunk (chunkSize);
+        StreamingBoundingPolygon boundingPolygon;
+        for (size_t pointCount = readPoints (chunk.data (), chunk.size ()); pointCount > 0; pointCount = readPoints (chunk.data (), chunk.size ()))
+            boundingPolygon.AddPoints (PointSpan (chunk.data (), pointCount));
+        return boundingPolygon.GetPolygon ();
+    }
+
+
+    struct ChainNode;
+    typedef std::shared_ptr<const ChainNode> ChainPointer;
+
+
+    // node of an immutable point sequence (treap with implicit keys)
+    // modifying a sequence creates new nodes along one path, the rest of the nodes are shared
+    struct ChainNode
+    {
+        Point point;
+        unsigned int priority;
+        size_t size;
+        ChainPointer left;
+        ChainPointer right;
+
+        ChainNode (const Point& point, unsigned int priority, const ChainPointer& left, const ChainPointer& right);
+    };
+
+
+    static size_t GetChainSize (const ChainPointer& chain)
+    {
+        return chain != nullptr ? chain->size : 0;
+    }
+
+
+    ChainNode::ChainNode (const Point& point, unsigned int priority, const ChainPointer& left, const ChainPointer& right) :
+        point (point),
+        priority (priority),
+        size (1 + GetChainSize (left) + GetChainSize (right)),
+        left (left),
+        right (right)
+    {}
+
+
+    static ChainPointer CopyChainNode (const ChainNode& node, const ChainPointer& left, const ChainPointer& right)
+    {
+        return std::make_shared<const ChainNode> (node.point, node.priority, left, right);
+    }
+
+
+    static ChainPointer JoinChains (const ChainPointer& chain1, const ChainPointer& chain2)
+    {
+        if (chain1 == nullptr)
+            return chain2;
+        if (chain2 == nullptr)
+            return chain1;
+
+        if (chain1->priority > chain2->priority)
+            return CopyChainNode (*chain1, chain1->left, JoinChains (chain1->right, chain2));
+        else
+            return CopyChainNode (*chain2, JoinChains (chain1, chain2->left), chain2->right);
+    }
+
+
+    // the first count points of the chain, only the nodes on the path of the cut are copied
+    static ChainPointer GetChainPrefix (const ChainPointer& chain, size_t count)
+    {
+        if (count == 0)
+            return nullptr;
+        if (count >= GetChainSize (chain))
+            return chain;
+
+        const size_t leftSize = GetChainSize (chain->left);
+        if (count <= leftSize)
+            return GetChainPrefix (chain->left, count);
+        return CopyChainNode (*chain, chain->left, GetChainPrefix (chain->right, count - leftSize - 1));
+    }
+
+
+    // the points of the chain after the first count points
+    static ChainPointer GetChainSuffix (const ChainPointer& chain, size_t count)
+    {
+        if (count == 0)
+            return chain;
+        if (count >= GetChainSize (chain))
+            return nullptr;
+
+        const size_t leftSize = GetChainSize (chain->left);
+        if (count > leftSize)
+            return GetChainSuffix (chain->right, count - leftSize - 1);
+        return CopyChainNode (*chain, GetChainSuffix (chain->left, count), chain->right);
+    }
+
+
+    static const Point& GetChainPoint (const ChainPointer& chain, size_t index)
+    {
+        assert (index < GetChainSize (chain));
+
+        const ChainNode* node = chain.get ();
+        while (true) {
+            const size_t leftSize = GetChainSize (node->left);
+            if (index == leftSize)
+                return node->point;
+            if (index < leftSize) {
+                node = node->left.get ();
+            } else {
+                index -= leftSize + 1;
+                node = node->right.get ();
+            }
+        }
+    }
+
+
+    // a chain point with its neighbours, the missing neighbours are nullptr
+    struct ChainNeighbourhood
+    {
+        const Point* previousPoint;
+        const Point* point;
+        const Point* nextPoint;
+    };
+
+
+    // finds the neighbours of the point during the same search as the point
+    static ChainNeighbourhood GetChainNeighbourhood (const ChainPointer& chain, size_t index)
+    {
+        assert (index < GetChainSize (chain));
+
+        ChainNeighbourhood neighbourhood {nullptr, nullptr, nullptr};
+        const ChainNode* node = chain.get ();
+        while (true) {
+            const size_t leftSize = GetChainSize (node->left);
+            if (index == leftSize)
+                break;
+            if (index < leftSize) {
+                neighbourhood.nextPoint = &node->point;
+                node = node->left.get ();
+            } else {
+                index -= leftSize + 1;
+                neighbourhood.previousPoint = &node->point;
+                node = node->right.get ();
+            }
+        }
+
+        neighbourhood.point = &node->point;
+        if (node->left != nullptr) {
+            const ChainNode* previousNode = node->left.get ();
+            while (previousNode->right != nullptr)
+                previousNode = previousNode->right.get ();
+            neighbourhood.previousPoint = &previousNode->point;
+        }
+        if (node->right != nullptr) {
+            const ChainNode* nextNode = node->right.get ();
+            while (nextNode->left != nullptr)
+                nextNode = nextNode->left.get ();
+            neighbourhood.nextPoint = &nextNode->point;
+        }
+        return neighbourhood;
+    }
+
+
+    // number of chain points that precede the given point
+    static size_t FindChainPosition (const ChainPointer& chain, const Point& point)
+    {
+        size_t position = 0;
+        const ChainNode* node = chain.get ();
+        while (node != nullptr) {
+            if (PointComparator () (node->point, point)) {
+                position += GetChainSize (node->left) + 1;
+                node = node->right.get ();
+            } else {
+                node = node->left.get ();
+            }
+        }
+        return position;
+    }
+
+
+    static void AppendChainPoints (const ChainPointer& chain, Polygon& points)
+    {
+        if (chain == nullptr)
+            return;
+        AppendChainPoints (chain->left, points);
+        points.push_back (chain->point);
+        AppendChainPoints (chain->right, points);
+    }
+
+
+    // every point of leftChain has to precede every point of rightChain
+    // the chains are connected through their common tangent (bridge), the points under the bridge are dropped
+    // the bridge is searched in both chains at once (Overmars and van Leeuwen): every step drops half of the remaining candidates
+    // of at least one chain, so the search takes O(log n) steps
+    static ChainPointer MergeChains (const ChainPointer& leftChain, const ChainPointer& rightChain, Orientation convexTurn)
+    {
+        if (leftChain == nullptr)
+            return rightChain;
+        if (rightChain == nullptr)
+            return leftChain;
+
+        const long long sign = convexTurn == Orientation::CounterClockwise ? 1 : -1;
+        const size_t leftSize = GetChainSize (leftChain);
+        const size_t rightSize = GetChainSize (rightChain);
+        const Point& lastLeftPoint = GetChainPoint (leftChain, leftSize - 1);
+        const Point& firstRightPoint = GetChainPoint (rightChain, 0);
+        // a chain can start with a vertical edge, then both of its first points are on the vertical line between the chains
+        const Point& secondRightPoint = GetChainPoint (rightChain, rightSize > 1 ? 1 : 0);
+
+        // if more points are on the bridge, the leftmost one of the left chain and the rightmost one of the right chain are kept
+        size_t leftLowerIndex = 0;
+        size_t leftUpperIndex = leftSize - 1;
+        size_t rightLowerIndex = 0;
+        size_t rightUpperIndex = rightSize - 1;
+        while (true) {
+            const size_t leftIndex = (leftLowerIndex + leftUpperIndex) / 2;
+            const size_t rightIndex = (rightLowerIndex + rightUpperIndex) / 2;
+            const ChainNeighbourhood leftNeighbourhood = GetChainNeighbourhood (leftChain, leftIndex);
+            const ChainNeighbourhood rightNeighbourhood = GetChainNeighbourhood (rightChain, rightIndex);
+            const Point& leftPoint = *leftNeighbourhood.point;
+            const Point& rightPoint = *rightNeighbourhood.point;
+
+            // the neighbours of the candidates that are on the wrong side of the candidate line
+            const bool isLeftPreviousUnder = leftNeighbourhood.previousPoint != nullptr &&
+                                             sign * CrossProduct (leftPoint, rightPoint, *leftNeighbourhood.previousPoint) <= 0;
+            const bool isLeftNextUnder = leftNeighbourhood.nextPoint != nullptr &&
+                                         sign * CrossProduct (leftPoint, rightPoint, *leftNeighbourhood.nextPoint) < 0;
+            const bool isRightPreviousUnder = rightNeighbourhood.previousPoint != nullptr &&
+                                              sign * CrossProduct (leftPoint, rightPoint, *rightNeighbourhood.previousPoint) < 0;
+            const bool isRightNextUnder = rightNeighbourhood.nextPoint != nullptr &&
+                                          sign * CrossProduct (leftPoint, rightPoint, *rightNeighbourhood.nextPoint) <= 0;
+
+            if (!isLeftPreviousUnder && !isLeftNextUnder && !isRightPreviousUnder && !isRightNextUnder) {
+                return JoinChains (GetChainPrefix (leftChain, leftIndex + 1), GetChainSuffix (rightChain, rightIndex));
+            } else if (isLeftPreviousUnder || isRightNextUnder) {
+                // the edge before the left candidate or after the right candidate is under the candidate line, it can not be on the bridge
+                if (isLeftPreviousUnder)
+                    leftUpperIndex = leftIndex - 1;
+                if (isRightNextUnder)
+                    rightLowerIndex = rightIndex + 1;
+            } else if (!isRightPreviousUnder) {
+                // every point of the right chain is above the line of the edge after the left candidate
+                leftLowerIndex = leftIndex + 1;
+            } else if (!isLeftNextUnder) {
+                rightUpperIndex = rightIndex - 1;
+            } else {
+                // the line of the edge after the left candidate and the line of the edge before the right candidate cross each other
+                // the points on the other side of the vertical line between the chains are above the line of the edge on this side
+                const Point& leftNextPoint = *leftNeighbourhood.nextPoint;
+                const Point& rightPreviousPoint = *rightNeighbourhood.previousPoint;
+                const long long leftDirectionX = (long long)leftNextPoint.x - leftPoint.x;
+                const long long leftDirectionY = (long long)leftNextPoint.y - leftPoint.y;
+                const long long rightDirectionX = (long long)rightPoint.x - rightPreviousPoint.x;
+                const long long rightDirectionY = (long long)rightPoint.y - rightPreviousPoint.y;
+                const WideInteger denominator = Multiply (leftDirectionX, rightDirectionY) - Multiply (leftDirectionY, rightDirectionX);
+                const WideInteger numerator = Multiply ((long long)rightPreviousPoint.x - leftPoint.x, rightDirectionY) -
+                                              Multiply ((long long)rightPreviousPoint.y - leftPoint.y, rightDirectionX);
+                assert (denominator != 0 && leftDirectionX >= 0);
+
+                // x coord of the crossing compared to the x coord of the last left point
+                // the numerator needs 67 bits and the x differences 33 bits, so the products still fit into 128 bits
+                const int crossingSide = GetSign (denominator) *
+                                         GetSign (numerator * leftDirectionX - denominator * ((long long)lastLeftPoint.x - leftPoint.x));
+                const bool isRightChainAboveLeftEdge = crossingSide < 0 ||
+                                                       (crossingSide == 0 &&
+                                                        sign * CrossProduct (leftPoint, leftNextPoint, firstRightPoint) > 0 &&
+                                                        (secondRightPoint.x != firstRightPoint.x || sign * CrossProduct (leftPoint, leftNextPoint, secondRightPoint) > 0));
+                if (isRightChainAboveLeftEdge)
+                    leftLowerIndex = leftIndex + 1;
+                else
+                    rightUpperIndex = rightIndex - 1;
+            }
+            assert (leftLowerIndex <= leftUpperIndex && rightLowerIndex <= rightUpperIndex);
+        }
+    }
+
+
+
+    // false if the point is inside of the polygon or on the chain
+    static bool IsPointOutsideChain (const ChainPointer& chain, const Point& point, Orientation convexTurn)
+    {
+        const long long sign = convexTurn == Orientation::CounterClockwise ? 1 : -1;
+
+        const size_t position = FindChainPosition (chain, point);
+        if (position == GetChainSize (chain))
+            return true;
+        const Point& nextPoint = GetChainPoint (chain, position);
+        if (nextPoint == point)
+            return false;
+        if (position == 0)
+            return true;
+        return sign * CrossProduct (GetChainPoint (chain, position - 1), nextPoint, point) < 0;
+    }
+
+
+    static bool IsPointOnChain (const ChainPointer& chain, const Point& point)
+    {
+        const size_t position = FindChainPosition (chain, point);
+        return position < GetChainSize (chain) && GetChainPoint (chain, position) == point;
+    }
+
+
+    struct DynamicBoundingPolygon::Node
+    {
+        Point point;
+        unsigned int priority;
+        size_t size;
+        ChainPointer pointChain;
+        ChainPointer lowerChain;
+        ChainPointer upperChain;
+        bool areChainsUpToDate;
+        std::unique_ptr<Node> left;
+        std::unique_ptr<Node> right;
+
+        Node (const Point& point, unsigned int priority) :
+            point (point),
+            priority (priority),
+            size (1),
+            pointChain (std::make_shared<const ChainNode> (point, priority, nullptr, nullptr)),
+            lowerChain (pointChain),
+            upperChain (pointChain),
+            areChainsUpToDate (true)
+        {}
+    };
+
+
+    // the polygon of the subtree has changed, the chains are merged again only when they are needed
+    void DynamicBoundingPolygon::UpdateNode (Node& node)
+    {
+        UpdateNodeSize (node);
+        node.lowerChain.reset ();
+        node.upperChain.reset ();
+        node.areChainsUpToDate = false;
+    }
+
+
+    // used if the polygon of the subtree has not changed
+    void DynamicBoundingPolygon::UpdateNodeSize (Node& node)
+    {
+        node.size = 1;
+        if (node.left != nullptr)
+            node.size += node.left->size;
+        if (node.right != nullptr)
+            node.size += node.right->size;
+    }
+
+
+    // merges the outdated chains of the subtree again, the subtrees with up to date chains are skipped
+    void DynamicBoundingPolygon::UpdateChains (Node& node)
+    {
+        if (node.areChainsUpToDate)
+            return;
+
+        ChainPointer lowerChain = node.pointChain;
+        ChainPointer upperChain = node.pointChain;
+        if (node.left != nullptr) {
+            UpdateChains (*node.left);
+            lowerChain = MergeChains (node.left->lowerChain, lowerChain, Orientation::CounterClockwise);
+            upperChain = MergeChains (node.left->upperChain, upperChain, Orientation::Clockwise);
+        }
+        if (node.right != nullptr) {
+            UpdateChains (*node.right);
+            lowerChain = MergeChains (lowerChain, node.right->lowerChain, Orientation::CounterClockwise);
+            upperChain = MergeChains (upperChain, node.right->upperChain, Orientation::Clockwise);
+        }
+        node.lowerChain = std::move (lowerChain);
+        node.upperChain = std::move (upperChain);
+        node.areChainsUpToDate = true;
+    }
+
+
+    // the points of the tree have changed, but its polygon has not, so the root keeps its chains
+    void DynamicBoundingPolygon::KeepRootChains (const ChainPointer& lowerChain, const ChainPointer& upperChain)
+    {
+        if (root == nullptr)
+            return;
+        root->lowerChain = lowerChain;
+        root->upperChain = upperChain;
+        root->areChainsUpToDate = true;
+    }
+
+
+    std::unique_ptr<DynamicBoundingPolygon::Node> DynamicBoundingPolygon::RotateRight (std::unique_ptr<Node> node)
+    {
+        std::unique_ptr<Node> leftNode = std::move (node->left);
+        node->left = std::move (leftNode->right);
+        UpdateNode (*node);
+        leftNode->right = std::move (node);
+        UpdateNode (*leftNode);
+        return leftNode;
+    }
+
+
+    std::unique_ptr<DynamicBoundingPolygon::Node> DynamicBoundingPolygon::RotateLeft (std::unique_ptr<Node> node)
+    {
+        std::unique_ptr<Node> rightNode = std::move (node->right);
+        node->right = std::move (rightNode->left);
+        UpdateNode (*node);
+        rightNode->left = std::move (node);
+        UpdateNode (*rightNode);
+        return rightNode;
+    }
+
+
+    DynamicBoundingPolygon::DynamicBoundingPolygon () :
+        priorityState (2463534242u)
+    {}
+
+
+    DynamicBoundingPolygon::~DynamicBoundingPolygon () = default;
+
+
+    unsigned int DynamicBoundingPolygon::GeneratePriority ()
+    {
+        priorityState ^= priorityState << 13;
+        priorityState ^= priorityState >> 17;
+        priorityState ^= priorityState << 5;
+        return priorityState;
+    }
+
+
+    std::unique_ptr<DynamicBoundingPolygon::Node> DynamicBoundingPolygon::InsertToSubtree (std::unique_ptr<Node> node, const Point& newPoint, bool isPointOutside, bool& inserted)
+    {
+        if (node == nullptr) {
+            inserted = true;
+            return std::make_unique<Node> (newPoint, GeneratePriority ());
+        }
+        if (node->point == newPoint) {
+            inserted = false;
+            return node;
+        }
+
+        // if the point is outside of the polygon of the node, it is outside of the polygons below it too
+        // the nodes that keep their polygon keep their chains, the chains of the rest are merged again when they are needed
+        const bool isPointInside = !isPointOutside && node->areChainsUpToDate &&
+                                   !IsPointOutsideChain (node->lowerChain, newPoint, Orientation::CounterClockwise) &&
+                                   !IsPointOutsideChain (node->upperChain, newPoint, Orientation::Clockwise);
+        const bool isPointOutsideOfNode = isPointOutside || (node->areChainsUpToDate && !isPointInside);
+        if (PointComparator () (newPoint, node->point)) {
+            node->left = InsertToSubtree (std::move (node->left), newPoint, isPointOutsideOfNode, inserted);
+            if (inserted && node->left->priority > node->priority)
+                return RotateRight (std::move (node));
+        } else {
+            node->right = InsertToSubtree (std::move (node->right), newPoint, isPointOutsideOfNode, inserted);
+            if (inserted && node->right->priority > node->priority)
+                return RotateLeft (std::move (node));
+        }
+
+        if (inserted && isPointInside)
+            UpdateNodeSize (*node);
+        else if (inserted)
+            UpdateNode (*node);
+        return node;
+    }
+
+
+    std::unique_ptr<DynamicBoundingPolygon::Node> DynamicBoundingPolygon::EraseFromSubtree (std::unique_ptr<Node> node, const Point& point, bool isPointOnParentPolygon, bool& erased)
+    {
+        if (node == nullptr) {
+            erased = false;
+            return node;
+        }
+
+        if (node->point == point) {
+            erased = true;
+            if (node->left == nullptr)
+                return std::move (node->right);
+            if (node->right == nullptr)
+                return std::move (node->left);
+
+            // move the node down until it has at most one child
+            if (node->left->priority > node->right->priority) {
+                node = RotateRight (std::move (node));
+                node->right = EraseFromSubtree (std::move (node->right), point, false, erased);
+            } else {
+                node = RotateLeft (std::move (node));
+                node->left = EraseFromSubtree (std::move (node->left), point, false, erased);
+            }
+            if (erased)
+                UpdateNode (*node);
+            return node;
+        }
+
+        // if the point is a corner of the polygon of the node, it is a corner of the polygons below it too
+        const bool isPointOnPolygon = isPointOnParentPolygon ||
+                                      (node->areChainsUpToDate && (IsPointOnChain (node->lowerChain, point) || IsPointOnChain (node->upperChain, point)));
+        if (PointComparator () (point, node->point))
+            node->left = EraseFromSubtree (std::move (node->left), point, isPointOnPolygon, erased);
+        else
+            node->right = EraseFromSubtree (std::move (node->right), point, isPointOnPolygon, erased);
+
+        if (erased && node->areChainsUpToDate && !isPointOnPolygon)
+            UpdateNodeSize (*node);
+        else if (erased)
+            UpdateNode (*node);
+        return node;
+    }
+
+
+    // returns true if the bounding polygon has changed
+    bool DynamicBoundingPolygon::AddPoint (const Point& newPoint)
+    {
+        const bool isPointOutside = root == nullptr ||
+                                    IsPointOutsideChain (root->lowerChain, newPoint, Orientation::CounterClockwise) ||
+                                    IsPointOutsideChain (root->upperChain, newPoint, Orientation::Clockwise);
+
+        const ChainPointer lowerChain = root != nullptr ? root->lowerChain : nullptr;
+        const ChainPointer upperChain = root != nullptr ? root->upperChain : nullptr;
+        bool inserted = false;
+        root = InsertToSubtree (std::move (root), newPoint, isPointOutside, inserted);
+        if (isPointOutside)
+            UpdateChains (*root);
+        else
+            KeepRootChains (lowerChain, upperChain);
+        return inserted && isPointOutside;
+    }
+
+
+    // returns true if the bounding polygon has changed
+    // removing a point that is not a corner of the polygon does not change the polygon
+    bool DynamicBoundingPolygon::RemovePoint (const Point& point)
+    {
+        if (root == nullptr)
+            return false;
+
+        const bool isPointOnPolygon = IsPointOnChain (root->lowerChain, point) || IsPointOnChain (root->upperChain, point);
+
+        const ChainPointer lowerChain = root->lowerChain;
+        const ChainPointer upperChain = root->upperChain;
+        bool erased = false;
+        root = EraseFromSubtree (std::move (root), point, isPointOnPolygon, erased);
+        if (root != nullptr && isPointOnPolygon)
+            UpdateChains (*root);
+        else
+            KeepRootChains (lowerChain, upperChain);
+        return erased && isPointOnPolygon;
+    }
+
+
+    void DynamicBoundingPolygon::Clear ()
+    {
+        root.reset ();
+    }
+
+
+    size_t DynamicBoundingPolygon::GetPointCount () const
+    {
+        return root != nullptr ? root->size : 0;
+    }
+
+
+    // the extremes of the points are corners of their polygon, so they are read from the chains of the root
+    // both chains go from the leftmost to the rightmost point (compared by PointComparator)
+    Point DynamicBoundingPolygon::GetLeftMostPoint () const
+    {
+        assert (root != nullptr);
+        return GetChainPoint (root->lowerChain, 0);
+    }
+
+
+    Point DynamicBoundingPolygon::GetRightMostPoint () const
+    {
+        assert (root != nullptr);
+        return GetChainPoint (root->lowerChain, root->lowerChain->size - 1);
+    }
+
+
+    // the index of the first chain point whose next point is not farther in the direction given by the sign
+    // the chain is convex, so the y coords first move in this direction and then turn back, and the turning point is found with a binary search
+    static size_t FindChainPointWithExtremeYCoord (const ChainPointer& chain, int directionSign)
+    {
+        size_t firstIndex = 0;
+        size_t lastIndex = GetChainSize (chain) - 1;
+        while (firstIndex < lastIndex) {
+            const size_t middleIndex = firstIndex + (lastIndex - firstIndex) / 2;
+            const long long yCoordStep = (long long)GetChainPoint (chain, middleIndex + 1).y - GetChainPoint (chain, middleIndex).y;
+            if (directionSign * yCoordStep <= 0)
+                lastIndex = middleIndex;
+            else
+                firstIndex = middleIndex + 1;
+        }
+        return firstIndex;
+    }
+
+
+    // the lowest point is on the lower chain and the highest one is on the upper chain, so it takes O(log^2 n) time
+    PointBounds DynamicBoundingPolygon::GetPointBounds () const
+    {
+        assert (root != nullptr);
+        const int minYCoord = GetChainPoint (root->lowerChain, FindChainPointWithExtremeYCoord (root->lowerChain, -1)).y;
+        const int maxYCoord = GetChainPoint (root->upperChain, FindChainPointWithExtremeYCoord (root->upperChain, 1)).y;
+        return {GetLeftMostPoint ().x, GetRightMostPoint ().x, minYCoord, maxYCoord};
+    }
+
+
+    // false if there are less than 3 points, or all of the points are in one line
+    bool DynamicBoundingPolygon::IsValidPolygon () const
+    {
+        return GetSnapshot ().IsValidPolygon ();
+    }
+
+
+    Polygon DynamicBoundingPolygon::GetPolygon () const
+    {
+        return GetSnapshot ().GetPolygon ();
+    }
+
+
+    BoundingPolygonSnapshot DynamicBoundingPolygon::GetSnapshot () const
+    {
+        if (root == nullptr)
+            return BoundingPolygonSnapshot ();
+        return BoundingPolygonSnapshot (root->lowerChain, root->upperChain);
+    }
+
+
+    BoundingPolygonSnapshot::BoundingPolygonSnapshot () = default;
+
+
+    BoundingPolygonSnapshot::BoundingPolygonSnapshot (const ChainPointer& lowerChain, const ChainPointer& upperChain) :
+        lowerChain (lowerChain),
+        upperChain (upperChain)
+    {}
+
+
+    bool BoundingPolygonSnapshot::IsValidPolygon () const
+    {
+        return GetChainSize (lowerChain) + GetChainSize (upperChain) > 4;
+    }
+
+
+    // same order as CalculateBoundingPolygon: counter-clockwise, starting with the leftmost point
+    Polygon BoundingPolygonSnapshot::GetPolygon () const
+    {
+        Polygon polygon;
+        if (lowerChain == nullptr)
+            return polygon;
+
+        Polygon upperChainPoints;
+        AppendChainPoints (lowerChain, polygon);
+        AppendChainPoints (upperChain, upperChainPoints);
+        if (upperChainPoints.size () > 2)
+            polygon.insert (polygon.end (), std::next (upperChainPoints.rbegin ()), std::prev (upperChainPoints.rend ()));
+        return polygon;
     }
-}
+}
\ No newline at end of file
@@ -1,10 +1,16 @@
 #ifndef GEOMETRY_HPP
 #define GEOMETRY_HPP
 
+#include <functional>
 #include <memory>
 #include <unordered_set>
 #include <vector>
 
+namespace Parallel
+{
+    class WorkStealingPool;
+}
+
 namespace Geometry
 {
     struct Point
@@ -32,9 +38,116 @@ namespace Geometry
     };
 
 
+    // orders the points from left to right, and from bottom to top if they have the same x coord
+    struct PointComparator
+    {
+        bool operator() (const Point& point1, const Point& point2) const;
+    };
+
+
     typedef PointHashFunction<Point> GeometryPointHashFunction;
     typedef std::unordered_set<Point, GeometryPointHashFunction> PointSet;
     typedef std::vector<Point> Polygon;
+    typedef std::vector<Point> PointArray;
+
+
+    // non-owning view of contiguous points, the points may contain duplicates
+    struct PointSpan
+    {
+        const Point* data;
+        size_t size;
+
+        PointSpan (const Point* data, size_t size) : data (data), size (size) {}
+        PointSpan (const PointArray& points) : data (points.data ()), size (points.size ()) {}
+
+        const Point* begin () const { return data; }
+        const Point* end () const { return data + size; }
+    };
+
+
+    const size_t PointSourceChunkSize = 1024;
+
+
+    // points of a container that is not a Point array, they are read in chunks, and every pass reads them again
+    // this way the algorithms can run on other containers (other point types, other coordinate systems) without copying them
+    class PointSource
+    {
+    public:
+        typedef std::function<void (PointSpan chunk)> ChunkVisitor;
+
+        virtual ~PointSource ();
+        virtual size_t GetPointCount () const = 0;
+        virtual void VisitPoints (const ChunkVisitor& visitChunk) const = 0;
+    };
+
+
+    // the converter makes a Point from an element of the container, it is only called while a chunk is read
+    template <typename Container, typename Converter>
+    class ConvertedPointSource : public PointSource
+    {
+        const Container& container;
+        Converter convert;
+    public:
+        ConvertedPointSource (const Container& container, Converter convert = Converter ()) : container (container), convert (convert) {}
+
+        virtual size_t GetPointCount () const override
+        {
+            return container.size ();
+        }
+
+        virtual void VisitPoints (const ChunkVisitor& visitChunk) const override
+        {
+            Point chunk[PointSourceChunkSize];
+            size_t chunkSize = 0;
+            for (const auto& element : container) {
+                chunk[chunkSize++] = convert (element);
+                if (chunkSize == PointSourceChunkSize) {
+                    visitChunk (PointSpan (chunk, chunkSize));
+                    chunkSize = 0;
+                }
+            }
+            if (chunkSize > 0)
+                visitChunk (PointSpan (chunk, chunkSize));
+        }
+    };
+
+
+    struct PointBounds
+    {
+        int minXCoord;
+        int maxXCoord;
+        int minYCoord;
+        int maxYCoord;
+    };
+
+    struct CulledPointSet
+    {
+        PointSet points;
+        size_t culledPointCount;
+    };
+
+    struct CulledPointArray
+    {
+        PointArray points;
+        size_t culledPointCount;
+    };
+
+    // statistics of the last CalculateBoundingPolygon or FindNextPointInBoundingPolygon call on the current thread
+    // they are only collected if GEOMETRY_INSTRUMENTATION is defined, otherwise every value stays 0
+    // the counters are thread local, so the work done on other threads (the parallel and the pool versions) is not counted
+    // validation is the time of the precondition checks (0 without asserts), preprocessing is the preparation of the input,
+    // search is the time spent finding the corners
+    struct BoundingPolygonStatistics
+    {
+        size_t wrapIterationCount = 0;
+        size_t examinedPointCount = 0;
+        size_t orientationTestCount = 0;
+        size_t slopeComparisonCount = 0;
+        size_t verticalLineCaseCount = 0;
+        long long validationNanoseconds = 0;
+        long long preprocessingNanoseconds = 0;
+        long long searchNanoseconds = 0;
+    };
 
     enum class SearchDirection
     {
@@ -42,6 +155,36 @@ namespace Geometry
         Left
     };
 
+    enum class Orientation
+    {
+        CounterClockwise,
+        Clockwise,
+        Collinear
+    };
+
+    enum class PointLocation : unsigned char
+    {
+        Inside,
+        OnBoundary,
+        Outside
+    };
+
+    enum class BoundingPolygonAlgorithm
+    {
+        GiftWrapping,
+        MonotoneChain,
+        Chan,
+        QuickHull
+    };
+
+    // ordered from the narrowest to the widest instruction set
+    enum class VectorInstructionSet
+    {
+        None,
+        SSE41,
+        AVX2
+    };
+
     struct GeneralLine
     {
         static std::unique_ptr<GeneralLine> CreateLine (const Point& point1, const Point& point2);
@@ -67,11 +210,131 @@ namespace Geometry
     };
 
 
+    Orientation GetOrientation (const Point& point1, const Point& point2, const Point& point3);
     Point FindLeftMostPoint (const PointSet& points);
+    Point FindLeftMostPoint (PointSpan points);
+    Point FindLeftMostPoint (const PointSource& points);
     Point FindNextPointInBoundingPolygon (const PointSet& points, const Point& startPoint, SearchDirection searchDirection);
+    BoundingPolygonStatistics GetLastBoundingPolygonStatistics ();
+    VectorInstructionSet GetVectorInstructionSet ();
+    void LimitVectorInstructionSet (VectorInstructionSet instructionSet);
+    PointBounds CalculatePointBounds (const PointSet& points);
+    PointBounds CalculatePointBounds (const Point* points, size_t pointCount);
+    PointBounds CalculatePointBounds (const PointSource& points);
     bool AreAllPointsInOneLine (const PointSet& points);
-    std::vector<Point> CalculateBoundingPolygon (const PointSet& points);
+    bool AreAllPointsInOneLine (PointSpan points);
+    bool AreAllPointsInOneLine (const PointSource& points);
+    void RemoveDuplicatePoints (PointArray& points);
+    std::vector<Point> CalculateBoundingPolygon (const PointSet& points,
+                                                 BoundingPolygonAlgorithm algorithm = BoundingPolygonAlgorithm::GiftWrapping);
+    std::vector<Point> CalculateBoundingPolygon (PointSpan points,
+                                                 BoundingPolygonAlgorithm algorithm = BoundingPolygonAlgorithm::GiftWrapping);
+    std::vector<Point> CalculateBoundingPolygon (const PointSource& points,
+                                                 BoundingPolygonAlgorithm algorithm = BoundingPolygonAlgorithm::GiftWrapping);
+    std::vector<Point> CalculateBoundingPolygonInParallel (const PointSet& points, unsigned int threadCount);
+    std::vector<Point> CalculateBoundingPolygonInParallel (PointSpan points, unsigned int threadCount);
+    std::vector<Point> CalculateBoundingPolygonWithQuickHull (PointSpan points, Parallel::WorkStealingPool& pool);
+    std::vector<Point> CalculateBoundingPolygonWithQuickHull (PointSpan points, unsigned int threadCount);
+    CulledPointSet CullInteriorPoints (const PointSet& points);
+    CulledPointArray CullInteriorPoints (PointSpan points);
     bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, const PointSet& points);
+    bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, PointSpan points);
+    bool CheckIfPolygonContainsAllPoints (const std::vector<Point>& polygon, const PointSource& points);
+
+
+    // answers containment queries for a convex polygon in O(log n) time
+    // the polygon is split into triangles (wedges) around its first corner, and the wedge of a point is found with a binary search
+    class ConvexPolygonQuery
+    {
+        Polygon polygon;
+        PointBounds bounds;
+    public:
+        ConvexPolygonQuery (const Polygon& polygon);
+        bool Contains (const Point& point) const;
+        PointLocation Locate (const Point& point) const;
+        void LocatePoints (PointSpan points, PointLocation* locations) const;
+    };
+
+
+    void ClassifyPoints (const ConvexPolygonQuery& polygonQuery, PointSpan points, PointLocation* locations, unsigned int threadCount = 1);
+
+
+    // builds the bounding polygon of a point stream chunk by chunk
+    // only the corners of the current polygon are kept, the points of a new chunk that are inside of it are dropped
+    class StreamingBoundingPolygon
+    {
+        Polygon polygon;
+        std::vector<PointLocation> pointLocations;
+    public:
+        void AddPoints (PointSpan points);
+        void Clear ();
+        bool IsValidPolygon () const;
+        Polygon GetPolygon () const;
+    };
+
+
+    // fills the buffer with the next points of a stream, and returns their count, 0 at the end of the stream
+    typedef std::function<size_t (Point* buffer, size_t bufferSize)> PointStreamReader;
+
+    Polygon CalculateBoundingPolygonOfStream (const PointStreamReader& readPoints, size_t chunkSize);
+
+
+    struct ChainNode;
+
+
+    // the polygon of a DynamicBoundingPolygon at one moment, later changes of the polygon do not affect it
+    // it shares the immutable chains of the polygon, so taking it takes constant time, and it can be read on any thread
+    class BoundingPolygonSnapshot
+    {
+        std::shared_ptr<const ChainNode> lowerChain;
+        std::shared_ptr<const ChainNode> upperChain;
+    public:
+        BoundingPolygonSnapshot ();
+        BoundingPolygonSnapshot (const std::shared_ptr<const ChainNode>& lowerChain, const std::shared_ptr<const ChainNode>& upperChain);
+
+        bool IsValidPolygon () const;
+        Polygon GetPolygon () const;
+    };
+
+
+    // keeps the bounding polygon up to date while points are added and removed
+    // the points are stored in a balanced tree ordered by PointComparator, and every node stores the lower and the upper
+    // chain of its subtree as an immutable sequence that shares its unchanged parts with the chains of the child nodes
+    // adding or removing a point only changes the chains along one path of the tree, and only the chains whose polygon changes:
+    // a point inside of the polygon of a node is found with a binary search on its chains, and the node keeps its chains
+    // the changed chains below the root are only marked as outdated, they are merged again when a polygon above them changes
+    class DynamicBoundingPolygon
+    {
+        struct Node;
+
+        std::unique_ptr<Node> root;
+        unsigned int priorityState;
+
+        static void UpdateNode (Node& node);
+        static void UpdateNodeSize (Node& node);
+        static void UpdateChains (Node& node);
+        static std::unique_ptr<Node> RotateRight (std::unique_ptr<Node> node);
+        static std::unique_ptr<Node> RotateLeft (std::unique_ptr<Node> node);
+
+        void KeepRootChains (const std::shared_ptr<const ChainNode>& lowerChain, const std::shared_ptr<const ChainNode>& upperChain);
+        unsigned int GeneratePriority ();
+        std::unique_ptr<Node> InsertToSubtree (std::unique_ptr<Node> node, const Point& newPoint, bool isPointOutside, bool& inserted);
+        std::unique_ptr<Node> EraseFromSubtree (std::unique_ptr<Node> node, const Point& point, bool isPointOnParentPolygon, bool& erased);
+    public:
+        DynamicBoundingPolygon ();
+        ~DynamicBoundingPolygon ();
+
+        bool AddPoint (const Point& newPoint);
+        bool RemovePoint (const Point& point);
+        void Clear ();
+        size_t GetPointCount () const;
+        Point GetLeftMostPoint () const;
+        Point GetRightMostPoint () const;
+        PointBounds GetPointBounds () const;
+        bool IsValidPolygon () const;
+        Polygon GetPolygon () const;
+        BoundingPolygonSnapshot GetSnapshot () const;
+    };
 }
 
 
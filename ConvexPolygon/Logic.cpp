@@ -4,35 +4,48 @@
 
 namespace Logic
 {
-	Geometry::PointSet ConvertUIPointsToLogicalPoints (const Model::UIPointSet& uiPoints)
+	Geometry::Point ConvertUIPointToLogicalPoint (const wxPoint& uiPoint)
 	{
-		Geometry::PointSet logicalPoints;
-		for (const wxPoint& point : uiPoints) {
-			Geometry::Point reversedPoint {point.x, -point.y};
-			logicalPoints.insert (reversedPoint);
-		}
-		return logicalPoints;
+		return Geometry::Point {uiPoint.x, -uiPoint.y};
+	}
+
+
+	wxPoint ConvertLogicalPointToUIPoint (const Geometry::Point& logicalPoint)
+	{
+		return wxPoint {logicalPoint.x, -logicalPoint.y};
 	}
 
 
 	Model::UIPolygon ConvertLogicalPointsToUIPoints (Geometry::Polygon& logicalPoints)
 	{
 		Model::UIPolygon uiPoints;
-		for (Geometry::Point& point : logicalPoints) {
-			wxPoint reversedPoint {point.x, -point.y};
-			uiPoints.push_back (reversedPoint);
-		}
+		for (Geometry::Point& point : logicalPoints)
+			uiPoints.push_back (ConvertLogicalPointToUIPoint (point));
 		return uiPoints;
 	}
 
 
-	Model::UIPolygon CalculateBoundingPolygon (const Model::UIPointSet& points)
+	Model::UIPolygon GetBoundingPolygon (const Geometry::BoundingPolygonSnapshot& snapshot)
+	{
+		if (!snapshot.IsValidPolygon ())
+			return Model::UIPolygon ();
+
+		Geometry::Polygon polygonPoints = snapshot.GetPolygon ();
+
+		assert (polygonPoints.size () > 2);
+
+		polygonPoints.push_back (polygonPoints[0]);
+		return ConvertLogicalPointsToUIPoints (polygonPoints);
+	}
+
+
+	Model::UIPolygon CalculateBoundingPolygon (const Model::UIPointSet& points, Geometry::BoundingPolygonAlgorithm algorithm)
 	{
-		Geometry::PointSet logicalPoints = ConvertUIPointsToLogicalPoints (points);
+		const UIPointSource logicalPoints (points);
 		if (points.size () < 3 || Geometry::AreAllPointsInOneLine (logicalPoints))
 			return Model::UIPolygon ();
 
-		Geometry::Polygon polygonPoints = Geometry::CalculateBoundingPolygon (logicalPoints);
+		Geometry::Polygon polygonPoints = Geometry::CalculateBoundingPolygon (logicalPoints, algorithm);
 
 		assert (polygonPoints.size () > 2);
 		assert (Geometry::CheckIfPolygonContainsAllPoints (polygonPoints, logicalPoints));
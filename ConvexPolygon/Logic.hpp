@@ -8,10 +8,25 @@
 
 namespace Logic
 {
-	Geometry::PointSet ConvertUIPointsToLogicalPoints (const Model::UIPointSet& uiPoints);
+	Geometry::Point ConvertUIPointToLogicalPoint (const wxPoint& uiPoint);
+
+	struct UIPointToLogicalPoint
+	{
+		Geometry::Point operator() (const wxPoint& uiPoint) const
+		{
+			return ConvertUIPointToLogicalPoint (uiPoint);
+		}
+	};
+
+	// reads the points of the canvas as logical points without copying the whole set
+	typedef Geometry::ConvertedPointSource<Model::UIPointSet, UIPointToLogicalPoint> UIPointSource;
+
+	wxPoint ConvertLogicalPointToUIPoint (const Geometry::Point& logicalPoint);
 	Model::UIPolygon ConvertLogicalPointsToUIPoints (Geometry::Polygon& logicalPoints);
 
-	Model::UIPolygon CalculateBoundingPolygon (const Model::UIPointSet& points);
+	Model::UIPolygon GetBoundingPolygon (const Geometry::BoundingPolygonSnapshot& snapshot);
+	Model::UIPolygon CalculateBoundingPolygon (const Model::UIPointSet& points,
+												Geometry::BoundingPolygonAlgorithm algorithm = Geometry::BoundingPolygonAlgorithm::GiftWrapping);
 }
 
 
@@ -1,12 +1,171 @@
 #include "Model.hpp"
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "Logic.hpp"
+
 namespace Model
 {
+    const int GridCellSize = 32;
+
+
+    static int GetCellCoord (int coord)
+    {
+        return coord >= 0 ? coord / GridCellSize : (coord + 1) / GridCellSize - 1;
+    }
+
+
+    // the coordinate is clamped, so positions far outside of the int range do not overflow
+    static int GetCellCoord (double coord)
+    {
+        return GetCellCoord ((int) std::floor (std::min (std::max (coord, (double) INT_MIN), (double) INT_MAX)));
+    }
+
+
+    static long long GetCellKey (int cellX, int cellY)
+    {
+        return (long long) (((unsigned long long) (unsigned int) cellX << 32) | (unsigned int) cellY);
+    }
+
+
+    // if the range has more cells than the grid, the occupied cells are checked instead of looking up every cell of the range
+    template <typename CellVisitor>
+    void PointGrid::VisitCells (int firstCellX, int firstCellY, int lastCellX, int lastCellY, const CellVisitor& visitCell) const
+    {
+        const double rangeCellCount = ((double) lastCellX - firstCellX + 1) * ((double) lastCellY - firstCellY + 1);
+        if (rangeCellCount > (double) cells.size ()) {
+            for (const auto& cell : cells) {
+                const int cellX = (int) (cell.first >> 32);
+                const int cellY = (int) (unsigned int) cell.first;
+                if (cellX >= firstCellX && cellX <= lastCellX && cellY >= firstCellY && cellY <= lastCellY)
+                    visitCell (cell.second);
+            }
+            return;
+        }
+
+        for (long long cellY = firstCellY; cellY <= lastCellY; cellY++) {
+            for (long long cellX = firstCellX; cellX <= lastCellX; cellX++) {
+                const auto cell = cells.find (GetCellKey ((int) cellX, (int) cellY));
+                if (cell != cells.end ())
+                    visitCell (cell->second);
+            }
+        }
+    }
+
+
+    void PointGrid::Clear ()
+    {
+        cells.clear ();
+    }
+
+
+    void PointGrid::AddPoint (const wxPoint& point)
+    {
+        cells[GetCellKey (GetCellCoord (point.x), GetCellCoord (point.y))].push_back (point);
+    }
+
+
+    void PointGrid::RemovePoint (const wxPoint& point)
+    {
+        const auto cell = cells.find (GetCellKey (GetCellCoord (point.x), GetCellCoord (point.y)));
+        if (cell == cells.end ())
+            return;
+
+        std::vector<wxPoint>& cellPoints = cell->second;
+        const auto pointInCell = std::find (cellPoints.begin (), cellPoints.end (), point);
+        if (pointInCell == cellPoints.end ())
+            return;
+        *pointInCell = cellPoints.back ();
+        cellPoints.pop_back ();
+        if (cellPoints.empty ())
+            cells.erase (cell);
+    }
+
+
+    // finds the point closest to the position within the radius, only the cells overlapping the circle are checked
+    bool PointGrid::FindNearestPoint (const wxRealPoint& position, double radius, wxPoint& nearestPoint) const
+    {
+        double nearestDistanceSquare = radius * radius;
+        bool found = false;
+        VisitCells (GetCellCoord (position.x - radius), GetCellCoord (position.y - radius),
+                    GetCellCoord (position.x + radius), GetCellCoord (position.y + radius),
+                    [&] (const std::vector<wxPoint>& cellPoints) {
+                        for (const wxPoint& point : cellPoints) {
+                            const double dx = point.x - position.x;
+                            const double dy = point.y - position.y;
+                            if (dx * dx + dy * dy <= nearestDistanceSquare) {
+                                nearestDistanceSquare = dx * dx + dy * dy;
+                                nearestPoint = point;
+                                found = true;
+                            }
+                        }
+                    });
+        return found;
+    }
+
+
+    void PointGrid::FindPointsInRect (const wxRect& rect, std::vector<wxPoint>& result) const
+    {
+        result.clear ();
+        if (rect.IsEmpty ())
+            return;
+
+        VisitCells (GetCellCoord (rect.GetLeft ()), GetCellCoord (rect.GetTop ()), GetCellCoord (rect.GetRight ()), GetCellCoord (rect.GetBottom ()),
+                    [&] (const std::vector<wxPoint>& cellPoints) {
+                        for (const wxPoint& point : cellPoints) {
+                            if (rect.Contains (point))
+                                result.push_back (point);
+                        }
+                    });
+    }
+
+
+    PointSetSummary::PointSetSummary (const Geometry::DynamicBoundingPolygon& boundingPolygon) :
+        boundingPolygon (boundingPolygon)
+    {}
+
+
+    size_t PointSetSummary::GetPointCount () const
+    {
+        return boundingPolygon.GetPointCount ();
+    }
+
+
+    // the y coordinates of the canvas are inverted, so the top of the box comes from the largest logical y
+    wxRect PointSetSummary::GetBoundingBox () const
+    {
+        if (boundingPolygon.GetPointCount () == 0)
+            return wxRect ();
+        const Geometry::PointBounds bounds = boundingPolygon.GetPointBounds ();
+        return wxRect (wxPoint (bounds.minXCoord, -bounds.maxYCoord), wxPoint (bounds.maxXCoord, -bounds.minYCoord));
+    }
+
+
+    wxPoint PointSetSummary::GetLeftMostPoint () const
+    {
+        if (boundingPolygon.GetPointCount () == 0)
+            return wxPoint ();
+        return Logic::ConvertLogicalPointToUIPoint (boundingPolygon.GetLeftMostPoint ());
+    }
+
+
+    wxPoint PointSetSummary::GetRightMostPoint () const
+    {
+        if (boundingPolygon.GetPointCount () == 0)
+            return wxPoint ();
+        return Logic::ConvertLogicalPointToUIPoint (boundingPolygon.GetRightMostPoint ());
+    }
+
+
     CanvasDataUpdater::~CanvasDataUpdater () = default;
 
 
     CanvasData::CanvasData (CanvasDataUpdater& updater) :
+        summary (boundingPolygon),
         isPolygonUpToDate (true),
+        pointSetVersion (0),
         updater (updater)
     {}
 
@@ -23,26 +182,85 @@ namespace Model
     }
 
 
+    const Geometry::DynamicBoundingPolygon& CanvasData::GetBoundingPolygon () const
+    {
+        return boundingPolygon;
+    }
+
+
+    const Model::PointSetSummary& CanvasData::GetSummary () const
+    {
+        return summary;
+    }
+
+
+    // the dynamic polygon is kept up to date for every point, and it has at least three corners if the points are not in one line
+    // this covers every line, not only the horizontal and vertical ones
+    bool CanvasData::AreAllPointsInOneLine () const
+    {
+        return !boundingPolygon.IsValidPolygon ();
+    }
+
+
     bool CanvasData::IsPolygonUpToDate () const
     {
         return isPolygonUpToDate;
     }
 
 
+    // changes whenever a point is added or removed, so results calculated from an older point set can be recognized
+    unsigned long long CanvasData::GetPointSetVersion () const
+    {
+        return pointSetVersion;
+    }
+
+
+    bool CanvasData::FindNearestPoint (const wxRealPoint& position, double radius, wxPoint& nearestPoint) const
+    {
+        return pointGrid.FindNearestPoint (position, radius, nearestPoint);
+    }
+
+
+    void CanvasData::FindPointsInRect (const wxRect& rect, std::vector<wxPoint>& result) const
+    {
+        pointGrid.FindPointsInRect (rect, result);
+    }
+
+
     void CanvasData::ClearPoints ()
     {
         points.clear ();
+        pointGrid.Clear ();
+        pointSetVersion++;
         polygonPoints.clear ();
+        boundingPolygon.Clear ();
         updater.CanvasCleared ();
     }
 
 
     void CanvasData::AddPoint (const wxPoint& newPoint)
     {
-        points.insert (newPoint);
-        if (isPolygonUpToDate)
+        if (!points.insert (newPoint).second)
+            return;
+        pointGrid.AddPoint (newPoint);
+        pointSetVersion++;
+        // a point inside the current polygon does not invalidate it, and it is found before the tree updates any chain
+        if (boundingPolygon.AddPoint (Logic::ConvertUIPointToLogicalPoint (newPoint)))
+            isPolygonUpToDate = false;
+        updater.PointAdded (newPoint);
+    }
+
+
+    void CanvasData::RemovePoint (const wxPoint& point)
+    {
+        if (points.erase (point) == 0)
+            return;
+        pointGrid.RemovePoint (point);
+        pointSetVersion++;
+        // removing a point that is not a corner of the polygon does not invalidate it
+        if (boundingPolygon.RemovePoint (Logic::ConvertUIPointToLogicalPoint (point)))
             isPolygonUpToDate = false;
-        updater.PointAdded ();
+        updater.PointRemoved (point);
     }
 
 
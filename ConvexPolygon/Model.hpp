@@ -1,6 +1,8 @@
 #ifndef MODEL_HPP
 #define MODEL_HPP
 
+#include <unordered_map>
+#include <vector>
 #include "wx/wx.h"
 
 #include "Geometry.hpp"
@@ -11,10 +13,40 @@ namespace Model
     typedef std::unordered_set<wxPoint, UIPointHashFunction> UIPointSet;
     typedef std::vector<wxPoint> UIPolygon;
 
+    // uniform grid of square cells over the points, so the points near a position or in a rectangle can be found without scanning every point
+    class PointGrid
+    {
+        std::unordered_map<long long, std::vector<wxPoint>> cells;
+
+        template <typename CellVisitor>
+        void VisitCells (int firstCellX, int firstCellY, int lastCellX, int lastCellY, const CellVisitor& visitCell) const;
+    public:
+        void Clear ();
+        void AddPoint (const wxPoint& point);
+        void RemovePoint (const wxPoint& point);
+        bool FindNearestPoint (const wxRealPoint& position, double radius, wxPoint& nearestPoint) const;
+        void FindPointsInRect (const wxRect& rect, std::vector<wxPoint>& result) const;
+    };
+
+    // data derived from the point set, read from the dynamic polygon of the canvas, which is updated with every added and removed point
+    // the extremes of the points are corners of their polygon, so no query scans the points
+    // the leftmost and the rightmost points are compared like in Geometry: by x, then by the y of the logical coordinate system
+    class PointSetSummary
+    {
+        const Geometry::DynamicBoundingPolygon& boundingPolygon;
+    public:
+        PointSetSummary (const Geometry::DynamicBoundingPolygon& boundingPolygon);
+        size_t GetPointCount () const;
+        wxRect GetBoundingBox () const;
+        wxPoint GetLeftMostPoint () const;
+        wxPoint GetRightMostPoint () const;
+    };
+
     class CanvasDataUpdater
     {
     public:
-        virtual void PointAdded () = 0;
+        virtual void PointAdded (const wxPoint& newPoint) = 0;
+        virtual void PointRemoved (const wxPoint& removedPoint) = 0;
         virtual void CanvasCleared () = 0;
         virtual void PolygonUpdated () = 0;
         virtual ~CanvasDataUpdater ();
@@ -23,16 +55,27 @@ namespace Model
     class CanvasData
     {
         Model::UIPointSet points;
+        Model::PointGrid pointGrid;
         Model::UIPolygon polygonPoints;
+        Geometry::DynamicBoundingPolygon boundingPolygon;
+        Model::PointSetSummary summary;
         bool isPolygonUpToDate;
+        unsigned long long pointSetVersion;
         CanvasDataUpdater& updater;
     public:
         CanvasData (CanvasDataUpdater& updater);
         const Model::UIPointSet& GetPoints () const;
         const Model::UIPolygon& GetPolygonPoints () const;
+        const Geometry::DynamicBoundingPolygon& GetBoundingPolygon () const;
+        const Model::PointSetSummary& GetSummary () const;
+        bool AreAllPointsInOneLine () const;
         bool IsPolygonUpToDate () const;
+        unsigned long long GetPointSetVersion () const;
+        bool FindNearestPoint (const wxRealPoint& position, double radius, wxPoint& nearestPoint) const;
+        void FindPointsInRect (const wxRect& rect, std::vector<wxPoint>& result) const;
         void ClearPoints ();
         void AddPoint (const wxPoint& newPoint);
+        void RemovePoint (const wxPoint& point);
         void UpdatePolygon (const Model::UIPolygon& newPolygonPoints);
     };
 }
@@ -0,0 +1,262 @@
+#include "PointFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined (_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Storage
+{
+    static_assert (sizeof (Geometry::Point) == 2 * sizeof (std::int32_t), "the points of the file are used as Point arrays");
+
+    // the points are encoded in chunks of this size
+    static const size_t PointChunkSize = 4096;
+
+
+    static bool IsLittleEndianPlatform ()
+    {
+        const std::uint32_t value = 1;
+        unsigned char firstByte;
+        std::memcpy (&firstByte, &value, 1);
+        return firstByte == 1;
+    }
+
+
+    static void EncodeValue (unsigned char* bytes, std::uint64_t value, size_t byteCount)
+    {
+        for (size_t index = 0; index < byteCount; index++)
+            bytes[index] = (unsigned char) (value >> (8 * index));
+    }
+
+
+    static std::uint64_t DecodeValue (const unsigned char* bytes, size_t byteCount)
+    {
+        std::uint64_t value = 0;
+        for (size_t index = 0; index < byteCount; index++)
+            value |= (std::uint64_t) bytes[index] << (8 * index);
+        return value;
+    }
+
+
+    static void EncodeHeader (unsigned char* bytes, const PointFileHeader& header)
+    {
+        std::memcpy (bytes, header.magic, sizeof (header.magic));
+        EncodeValue (bytes + 4, header.version, 4);
+        EncodeValue (bytes + 8, header.flags, 4);
+        EncodeValue (bytes + 12, header.reserved, 4);
+        EncodeValue (bytes + 16, header.pointCount, 8);
+        EncodeValue (bytes + 24, header.polygonPointCount, 8);
+    }
+
+
+    static PointFileHeader DecodeHeader (const unsigned char* bytes)
+    {
+        PointFileHeader header;
+        std::memcpy (header.magic, bytes, sizeof (header.magic));
+        header.version = (std::uint32_t) DecodeValue (bytes + 4, 4);
+        header.flags = (std::uint32_t) DecodeValue (bytes + 8, 4);
+        header.reserved = (std::uint32_t) DecodeValue (bytes + 12, 4);
+        header.pointCount = DecodeValue (bytes + 16, 8);
+        header.polygonPointCount = DecodeValue (bytes + 24, 8);
+        return header;
+    }
+
+
+    static Geometry::Point DecodePoint (const unsigned char* bytes)
+    {
+        return Geometry::Point ((std::int32_t) (std::uint32_t) DecodeValue (bytes, 4), (std::int32_t) (std::uint32_t) DecodeValue (bytes + 4, 4));
+    }
+
+
+    static void WritePoints (std::ofstream& file, const Geometry::Point* points, size_t pointCount)
+    {
+        std::vector<unsigned char> bytes (std::min (pointCount, PointChunkSize) * sizeof (Geometry::Point));
+        for (size_t chunkBegin = 0; chunkBegin < pointCount; chunkBegin += PointChunkSize) {
+            const size_t chunkSize = std::min (pointCount - chunkBegin, PointChunkSize);
+            for (size_t index = 0; index < chunkSize; index++) {
+                EncodeValue (bytes.data () + index * 8, (std::uint32_t) points[chunkBegin + index].x, 4);
+                EncodeValue (bytes.data () + index * 8 + 4, (std::uint32_t) points[chunkBegin + index].y, 4);
+            }
+            file.write (reinterpret_cast<const char*> (bytes.data ()), chunkSize * sizeof (Geometry::Point));
+        }
+    }
+
+
+    static bool WritePointFile (const std::string& fileName, Geometry::PointSpan points, const Geometry::Point* polygonPoints, size_t polygonPointCount)
+    {
+        PointFileHeader header = {};
+        std::memcpy (header.magic, PointFileMagic, sizeof (header.magic));
+        header.version = PointFileVersion;
+        header.flags = polygonPoints != nullptr ? PointFileHasPolygon : 0;
+        header.pointCount = points.size;
+        header.polygonPointCount = polygonPointCount;
+        unsigned char headerBytes[PointFileHeaderSize];
+        EncodeHeader (headerBytes, header);
+
+        std::ofstream file (fileName, std::ios::binary | std::ios::trunc);
+        file.write (reinterpret_cast<const char*> (headerBytes), sizeof (headerBytes));
+        WritePoints (file, points.data, points.size);
+        if (polygonPoints != nullptr)
+            WritePoints (file, polygonPoints, polygonPointCount);
+        return file.good ();
+    }
+
+
+    bool WritePointFile (const std::string& fileName, Geometry::PointSpan points)
+    {
+        return WritePointFile (fileName, points, nullptr, 0);
+    }
+
+
+    bool WritePointFile (const std::string& fileName, Geometry::PointSpan points, const Geometry::Polygon& polygon)
+    {
+        return WritePointFile (fileName, points, polygon.data (), polygon.size ());
+    }
+
+
+    MappedPointFile::MappedPointFile () :
+        mappedData (nullptr),
+        mappedSize (0),
+        points (nullptr, 0),
+        polygon (nullptr, 0)
+    {
+    }
+
+
+    MappedPointFile::~MappedPointFile ()
+    {
+        Close ();
+    }
+
+
+    // the file handles are closed right after mapping, the mapped view keeps the file open
+    bool MappedPointFile::Open (const std::string& fileName)
+    {
+        Close ();
+
+#if defined (_WIN32)
+        HANDLE file = CreateFileA (fileName.c_str (), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx (file, &fileSize) && fileSize.QuadPart >= (LONGLONG) PointFileHeaderSize)
+            mapping = CreateFileMappingA (file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle (file);
+        if (mapping == nullptr)
+            return false;
+
+        mappedData = static_cast<const unsigned char*> (MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle (mapping);
+        if (mappedData == nullptr)
+            return false;
+        mappedSize = fileSize.QuadPart;
+#else
+        const int file = open (fileName.c_str (), O_RDONLY);
+        if (file < 0)
+            return false;
+
+        struct stat fileStatus;
+        void* data = MAP_FAILED;
+        if (fstat (file, &fileStatus) == 0 && fileStatus.st_size >= (off_t) PointFileHeaderSize)
+            data = mmap (nullptr, fileStatus.st_size, PROT_READ, MAP_SHARED, file, 0);
+        close (file);
+        if (data == MAP_FAILED)
+            return false;
+
+        mappedData = static_cast<const unsigned char*> (data);
+        mappedSize = fileStatus.st_size;
+#endif
+
+        if (!ReadHeader ()) {
+            Close ();
+            return false;
+        }
+        return true;
+    }
+
+
+    void MappedPointFile::Close ()
+    {
+        if (mappedData == nullptr)
+            return;
+
+#if defined (_WIN32)
+        UnmapViewOfFile (mappedData);
+#else
+        munmap (const_cast<unsigned char*> (mappedData), mappedSize);
+#endif
+        mappedData = nullptr;
+        mappedSize = 0;
+        decodedPoints.clear ();
+        decodedPoints.shrink_to_fit ();
+        points = Geometry::PointSpan (nullptr, 0);
+        polygon = Geometry::PointSpan (nullptr, 0);
+    }
+
+
+    bool MappedPointFile::IsOpen () const
+    {
+        return mappedData != nullptr;
+    }
+
+
+    Geometry::PointSpan MappedPointFile::GetPoints () const
+    {
+        return points;
+    }
+
+
+    bool MappedPointFile::HasPolygon () const
+    {
+        return polygon.size > 0;
+    }
+
+
+    Geometry::PointSpan MappedPointFile::GetPolygon () const
+    {
+        return polygon;
+    }
+
+
+    // the sizes in the header have to match the size of the file exactly
+    bool MappedPointFile::ReadHeader ()
+    {
+        const PointFileHeader header = DecodeHeader (mappedData);
+        if (std::memcmp (header.magic, PointFileMagic, sizeof (header.magic)) != 0 || header.version != PointFileVersion)
+            return false;
+        if ((header.flags & PointFileHasPolygon) == 0 && header.polygonPointCount != 0)
+            return false;
+
+        const std::uint64_t maxPointCount = (mappedSize - PointFileHeaderSize) / sizeof (Geometry::Point);
+        if (header.pointCount > maxPointCount || header.polygonPointCount > maxPointCount - header.pointCount)
+            return false;
+        if (PointFileHeaderSize + (header.pointCount + header.polygonPointCount) * sizeof (Geometry::Point) != mappedSize)
+            return false;
+
+        // the header size is a multiple of 8, so the points are aligned
+        const Geometry::Point* firstPoint = reinterpret_cast<const Geometry::Point*> (mappedData + PointFileHeaderSize);
+        if (!IsLittleEndianPlatform ()) {
+            const size_t pointCount = (size_t) (header.pointCount + header.polygonPointCount);
+            decodedPoints.resize (pointCount);
+            for (size_t index = 0; index < pointCount; index++)
+                decodedPoints[index] = DecodePoint (mappedData + PointFileHeaderSize + index * sizeof (Geometry::Point));
+            firstPoint = decodedPoints.data ();
+        }
+        points = Geometry::PointSpan (firstPoint, (size_t) header.pointCount);
+        polygon = Geometry::PointSpan (firstPoint + header.pointCount, (size_t) header.polygonPointCount);
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef POINT_FILE_HPP
+#define POINT_FILE_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "Geometry.hpp"
+
+namespace Storage
+{
+    // binary point file, all of the values are little-endian regardless of the platform
+    // the 32 byte header stores the fields below in this order without padding
+    // the header is followed by pointCount points and polygonPointCount polygon corners, every point is an int32 x and an int32 y coord
+    // the polygon is optional (polygonPointCount is 0 without it), it is the cached result of CalculateBoundingPolygon in the same order
+    struct PointFileHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint32_t reserved;
+        std::uint64_t pointCount;
+        std::uint64_t polygonPointCount;
+    };
+
+    const size_t PointFileHeaderSize = 32;
+    const char PointFileMagic[4] = {'C', 'V', 'X', 'P'};
+    const std::uint32_t PointFileVersion = 1;
+    const std::uint32_t PointFileHasPolygon = 1;
+
+    bool WritePointFile (const std::string& fileName, Geometry::PointSpan points);
+    bool WritePointFile (const std::string& fileName, Geometry::PointSpan points, const Geometry::Polygon& polygon);
+
+
+    // the file is mapped into the memory, and the points are used directly from the mapped pages without copying or parsing them
+    // on big-endian platforms the points are decoded into an array instead
+    // the spans are valid while the file is open
+    class MappedPointFile
+    {
+    public:
+        MappedPointFile ();
+        ~MappedPointFile ();
+
+        MappedPointFile (const MappedPointFile&) = delete;
+        MappedPointFile& operator= (const MappedPointFile&) = delete;
+
+        bool Open (const std::string& fileName);
+        void Close ();
+        bool IsOpen () const;
+
+        Geometry::PointSpan GetPoints () const;
+        bool HasPolygon () const;
+        Geometry::PointSpan GetPolygon () const;
+
+    private:
+        bool ReadHeader ();
+
+        const unsigned char* mappedData;
+        std::uint64_t mappedSize;
+        Geometry::PointArray decodedPoints;
+        Geometry::PointSpan points;
+        Geometry::PointSpan polygon;
+    };
+}
+
+
+#endif
\ No newline at end of file
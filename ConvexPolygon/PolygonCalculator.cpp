@@ -0,0 +1,75 @@
+#include "PolygonCalculator.hpp"
+
+#include "Logic.hpp"
+
+namespace UI
+{
+    PolygonCalculator::PolygonCalculator (wxEvtHandler& resultHandler, int resultEventId) :
+        resultHandler (resultHandler),
+        resultEventId (resultEventId),
+        lastRequestId (0),
+        worker (1)
+#if defined (GEOMETRY_INSTRUMENTATION)
+        , lastStatisticsRequestId (0),
+        statisticsWorker (1)
+#endif
+    {}
+
+
+    // the pending calculations are cancelled, so the worker thread only has to skip them before it stops
+    PolygonCalculator::~PolygonCalculator ()
+    {
+        Cancel ();
+#if defined (GEOMETRY_INSTRUMENTATION)
+        ++lastStatisticsRequestId;
+#endif
+    }
+
+
+    // the snapshot does not change while it is read on the worker thread, even if the points of the canvas change
+    void PolygonCalculator::Calculate (const Geometry::BoundingPolygonSnapshot& snapshot, unsigned long long pointSetVersion)
+    {
+        const unsigned long long requestId = ++lastRequestId;
+        worker.Submit ([this, requestId, snapshot, pointSetVersion] {
+            if (lastRequestId != requestId)
+                return;
+
+            const PolygonCalculationResult result {pointSetVersion, Logic::GetBoundingPolygon (snapshot)};
+            if (lastRequestId != requestId)
+                return;
+
+            wxThreadEvent* resultEvent = new wxThreadEvent (wxEVT_THREAD, resultEventId);
+            resultEvent->SetPayload (result);
+            resultHandler.QueueEvent (resultEvent);
+        });
+    }
+
+
+    void PolygonCalculator::Cancel ()
+    {
+        ++lastRequestId;
+    }
+
+
+#if defined (GEOMETRY_INSTRUMENTATION)
+    // gift wrapping can take long, so it runs on its own thread and does not delay the drawn polygon
+    // the statistics are collected per thread, so they are read on the same thread right after the calculation
+    void PolygonCalculator::MeasureStatistics (Model::UIPointSet points, int statisticsEventId)
+    {
+        const unsigned long long requestId = ++lastStatisticsRequestId;
+        statisticsWorker.Submit ([this, requestId, points = std::move (points), statisticsEventId] {
+            if (lastStatisticsRequestId != requestId)
+                return;
+
+            const bool isPolygon = !Logic::CalculateBoundingPolygon (points, Geometry::BoundingPolygonAlgorithm::GiftWrapping).empty ();
+            const PolygonStatisticsResult result {points.size (), isPolygon, Geometry::GetLastBoundingPolygonStatistics ()};
+            if (lastStatisticsRequestId != requestId)
+                return;
+
+            wxThreadEvent* resultEvent = new wxThreadEvent (wxEVT_THREAD, statisticsEventId);
+            resultEvent->SetPayload (result);
+            resultHandler.QueueEvent (resultEvent);
+        });
+    }
+#endif
+}
\ No newline at end of file
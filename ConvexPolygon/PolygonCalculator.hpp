@@ -0,0 +1,54 @@
+#ifndef POLYGON_CALCULATOR_HPP
+#define POLYGON_CALCULATOR_HPP
+
+#include <atomic>
+#include "wx/wx.h"
+
+#include "Geometry.hpp"
+#include "Model.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace UI
+{
+    // payload of the result event, the version is the version of the point set the polygon was calculated from
+    struct PolygonCalculationResult
+    {
+        unsigned long long pointSetVersion;
+        Model::UIPolygon polygon;
+    };
+
+#if defined (GEOMETRY_INSTRUMENTATION)
+    // payload of the statistics event, the statistics belong to a separate gift wrapping run on the given number of points
+    struct PolygonStatisticsResult
+    {
+        size_t pointCount;
+        bool isPolygon;
+        Geometry::BoundingPolygonStatistics statistics;
+    };
+#endif
+
+    // calculates the polygon on a background thread, and sends it to the handler in a wxThreadEvent with the given id
+    // a new calculation cancels the previous one, the result of a cancelled calculation is not sent
+    class PolygonCalculator
+    {
+        wxEvtHandler& resultHandler;
+        int resultEventId;
+        std::atomic<unsigned long long> lastRequestId;
+        Parallel::WorkStealingPool worker;
+#if defined (GEOMETRY_INSTRUMENTATION)
+        std::atomic<unsigned long long> lastStatisticsRequestId;
+        Parallel::WorkStealingPool statisticsWorker;
+#endif
+    public:
+        PolygonCalculator (wxEvtHandler& resultHandler, int resultEventId);
+        ~PolygonCalculator ();
+
+        void Calculate (const Geometry::BoundingPolygonSnapshot& snapshot, unsigned long long pointSetVersion);
+        void Cancel ();
+#if defined (GEOMETRY_INSTRUMENTATION)
+        void MeasureStatistics (Model::UIPointSet points, int statisticsEventId);
+#endif
+    };
+}
+
+#endif
\ No newline at end of file
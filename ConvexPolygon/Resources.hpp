@@ -8,6 +8,11 @@ namespace Resources
 	const char* DialogTitle = "Convex Bounding Polygon";
 	const char* ClearButtonText = "Clear Canvas";
 	const char* DrawPolygonButtonText = "Draw Polygon";
+	const char* LivePolygonCheckBoxText = "Live Polygon";
+	const char* StatisticsButtonText = "Statistics";
+	const char* NoPolygonText = "The points do not form a polygon.";
+	const char* StatisticsRunText = "Separate single-threaded gift wrapping run on a copy of the points.\n"
+									"The drawn polygon comes from the dynamic polygon, which is not measured.";
 }
 
 
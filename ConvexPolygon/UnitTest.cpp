@@ -1,10 +1,21 @@
 #include "UnitTest.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <string>
+#include <thread>
 
 #include "Geometry.hpp"
+#include "PointFile.hpp"
+#include "WorkStealingPool.hpp"
 
 namespace Test
 {
@@ -73,6 +84,26 @@ namespace Test
 			assert (mathematicalLine->yOffset - (-1 - (double)2 / 6) < eps);
 		}
 
+		{ // orientation - counter-clockwise, clockwise and collinear turns
+			assert (GetOrientation (Point (0,0), Point (2,0), Point (1,2)) == Orientation::CounterClockwise);
+			assert (GetOrientation (Point (0,0), Point (1,2), Point (2,0)) == Orientation::Clockwise);
+			assert (GetOrientation (Point (-1,-1), Point (1,1), Point (3,3)) == Orientation::Collinear);
+		}
+
+		{ // orientation - large coordinates
+			assert (GetOrientation (Point (-1000000000,0), Point (1000000000,1), Point (999999999,1)) == Orientation::CounterClockwise);
+			assert (GetOrientation (Point (-1000000000,0), Point (1000000000,1), Point (1000000000,0)) == Orientation::Clockwise);
+		}
+
+		{ // orientation - full int range, the products of the coordinate differences do not fit into 64 bits
+			const int minInt = std::numeric_limits<int>::min ();
+			const int maxInt = std::numeric_limits<int>::max ();
+			assert (GetOrientation (Point (minInt,minInt), Point (maxInt,minInt), Point (maxInt,maxInt)) == Orientation::CounterClockwise);
+			assert (GetOrientation (Point (minInt,minInt), Point (maxInt,maxInt), Point (maxInt - 1,maxInt)) == Orientation::CounterClockwise);
+			assert (GetOrientation (Point (minInt,minInt), Point (maxInt,maxInt), Point (maxInt,maxInt - 1)) == Orientation::Clockwise);
+			assert (GetOrientation (Point (minInt,minInt), Point (maxInt,maxInt), Point (0,0)) == Orientation::Collinear);
+		}
+
 		{ // find leftmost point - one-point set
 			const PointSet points = { {-2,-1} };
 			const Point leftMostPoint = FindLeftMostPoint (points);
@@ -178,6 +209,92 @@ namespace Test
 			assert (AreAllPointsInOneLine (points) == false);
 		}
 
+		{ // point bounds - point set
+			const PointSet points = {{0,5}, {-3,1}, {1,-1}, {7,-2}, {0,0}};
+			const PointBounds bounds = CalculatePointBounds (points);
+			assert (bounds.minXCoord == -3 && bounds.maxXCoord == 7);
+			assert (bounds.minYCoord == -2 && bounds.maxYCoord == 5);
+		}
+
+		{ // point bounds - point array, the number of points is not a multiple of the vector size
+			std::vector<Point> points;
+			for (int i = 0; i < 11; i++)
+				points.push_back (Point ((i * 5) % 11 - 4, (i * 3) % 7 - 2));
+			points.push_back (Point (-20,30));
+			const PointBounds bounds = CalculatePointBounds (points.data (), points.size ());
+			assert (bounds.minXCoord == -20 && bounds.maxXCoord == 6);
+			assert (bounds.minYCoord == -2 && bounds.maxYCoord == 30);
+			const PointBounds firstPointBounds = CalculatePointBounds (points.data (), 1);
+			assert (firstPointBounds.minXCoord == -4 && firstPointBounds.maxXCoord == -4);
+			assert (firstPointBounds.minYCoord == -2 && firstPointBounds.maxYCoord == -2);
+		}
+
+		{ // convex polygon query - inside, on the edges and outside
+			const ConvexPolygonQuery polygonQuery ({{0,0}, {4,0}, {6,3}, {4,6}, {0,6}});
+			assert (polygonQuery.Contains (Point (2,3)) == true);
+			assert (polygonQuery.Contains (Point (0,0)) == true);
+			assert (polygonQuery.Contains (Point (2,0)) == true);
+			assert (polygonQuery.Contains (Point (0,3)) == true);
+			assert (polygonQuery.Contains (Point (5,3)) == true);
+			assert (polygonQuery.Contains (Point (5,1)) == false);
+			assert (polygonQuery.Contains (Point (5,5)) == false);
+			assert (polygonQuery.Contains (Point (6,0)) == false);
+			assert (polygonQuery.Contains (Point (0,7)) == false);
+			assert (polygonQuery.Contains (Point (-1,3)) == false);
+		}
+
+		{ // convex polygon query - clockwise polygon
+			const ConvexPolygonQuery polygonQuery ({{0,0}, {0,4}, {4,4}, {4,0}});
+			assert (polygonQuery.Contains (Point (1,3)) == true);
+			assert (polygonQuery.Contains (Point (4,2)) == true);
+			assert (polygonQuery.Contains (Point (5,2)) == false);
+		}
+
+		{ // convex polygon query - location of points
+			const ConvexPolygonQuery polygonQuery ({{0,0}, {4,0}, {6,3}, {4,6}, {0,6}});
+			assert (polygonQuery.Locate (Point (2,3)) == PointLocation::Inside);
+			assert (polygonQuery.Locate (Point (0,0)) == PointLocation::OnBoundary);
+			assert (polygonQuery.Locate (Point (5,3)) == PointLocation::Inside);
+			assert (polygonQuery.Locate (Point (2,6)) == PointLocation::OnBoundary);
+			assert (polygonQuery.Locate (Point (0,3)) == PointLocation::OnBoundary);
+			assert (polygonQuery.Locate (Point (6,0)) == PointLocation::Outside);
+		}
+
+		{ // classify points - same result as locating the points one by one
+			const ConvexPolygonQuery polygonQuery ({{0,0}, {4,0}, {6,3}, {4,6}, {0,6}});
+			PointArray points;
+			for (int x = -2; x <= 8; x++) {
+				for (int y = -2; y <= 8; y++)
+					points.push_back (Point (x,y));
+			}
+			std::vector<PointLocation> locations (points.size ());
+			ClassifyPoints (polygonQuery, points, locations.data (), 3);
+			for (size_t index = 0; index < points.size (); index++)
+				assert (locations[index] == polygonQuery.Locate (points[index]));
+		}
+
+		{ // point array - leftmost point and points in one line
+			const PointArray points = {{3,1}, {-2,3}, {5,5}, {-2,-1}, {0,0}, {-2,-2}, {4,-7}};
+			assert (FindLeftMostPoint (points) == Point (-2,-2));
+			assert (AreAllPointsInOneLine (points) == false);
+			assert (AreAllPointsInOneLine (PointArray ({{0,5}, {0,1}, {0,-2}, {0,5}})) == true);
+		}
+
+		{ // point array - duplicates are removed only on request
+			PointArray points = {{1,1}, {0,0}, {1,1}, {2,0}, {0,0}};
+			RemoveDuplicatePoints (points);
+			assert (points == PointArray ({{0,0}, {1,1}, {2,0}}));
+		}
+
+		{ // point array - calculate polygon with duplicates
+			const PointArray points = {{1,2}, {0,0}, {1,1}, {2,0}, {0,0}, {1,2}, {2,0}};
+			const std::vector<Point> expectedPoints = {{0,0}, {2,0}, {1,2}};
+			assert (CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::GiftWrapping) == expectedPoints);
+			assert (CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain) == expectedPoints);
+			assert (CheckIfPolygonContainsAllPoints (expectedPoints, points) == true);
+			assert (CheckIfPolygonContainsAllPoints (expectedPoints, PointArray ({{2,2}})) == false);
+		}
+
 		{ // calculate polygon - simple triangle
 			const PointSet points = {{0,0}, {2,0}, {1,2}};
 			std::vector<Point> boundingPoints = CalculateBoundingPolygon (points);
@@ -227,6 +344,469 @@ namespace Test
 			assert (boundingPoints[3] == Point (2,3));
 		}
 
+		{ // calculate polygon with monotone chain - simple triangle
+			const PointSet points = {{0,0}, {2,0}, {1,2}};
+			std::vector<Point> boundingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (boundingPoints.size () == points.size ());
+			assert (boundingPoints[0] == Point (0,0));
+			assert (boundingPoints[1] == Point (2,0));
+			assert (boundingPoints[2] == Point (1,2));
+		}
+
+		{ // calculate polygon with monotone chain - all points needed, contains vertical lines
+			const PointSet points = {{0,0}, {0,2}, {2,0}, {1,2}, {2,1}};
+			std::vector<Point> boundingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (boundingPoints.size () == points.size ());
+			assert (boundingPoints[0] == Point (0,0));
+			assert (boundingPoints[1] == Point (2,0));
+			assert (boundingPoints[2] == Point (2,1));
+			assert (boundingPoints[3] == Point (1,2));
+			assert (boundingPoints[4] == Point (0,2));
+		}
+
+		{ // calculate polygon with monotone chain - collinear points are dropped
+			const PointSet points = {{1,2}, {1,1}, {1,0}, {2,0}, {0,0}, {0,1}, {0,2}};
+			std::vector<Point> boundingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (boundingPoints.size () == 4);
+			assert (boundingPoints[0] == Point (0,0));
+			assert (boundingPoints[1] == Point (2,0));
+			assert (boundingPoints[2] == Point (1,2));
+			assert (boundingPoints[3] == Point (0,2));
+		}
+
+		{ // calculate polygon with monotone chain - same result as gift wrapping
+			PointSet points;
+			for (int i = 0; i < 200; i++)
+				points.insert (Point ((i * 37) % 101 - 50, (i * 53) % 97 - 48));
+			std::vector<Point> giftWrappingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::GiftWrapping);
+			std::vector<Point> monotoneChainPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (giftWrappingPoints == monotoneChainPoints);
+		}
+
+		{ // calculate polygon with chan - same result as monotone chain, also with duplicate points
+			PointArray points;
+			for (int i = 0; i < 5000; i++)
+				points.push_back (Point ((i * 7919) % 1009 - 504, (i * 104729) % 997 - 498));
+			points.insert (points.end (), points.begin (), points.begin () + 100);
+			assert (CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::Chan) ==
+					CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain));
+		}
+
+		{ // calculate polygon - full int range with every algorithm and with the dynamic polygon
+			const int minInt = std::numeric_limits<int>::min ();
+			const int maxInt = std::numeric_limits<int>::max ();
+			const PointArray points = {{minInt,minInt}, {maxInt,minInt}, {maxInt,maxInt}, {0,maxInt}, {5,5}};
+			const PointSet pointSet (points.begin (), points.end ());
+			const std::vector<Point> boundingPoints = {{minInt,minInt}, {maxInt,minInt}, {maxInt,maxInt}, {0,maxInt}};
+			for (BoundingPolygonAlgorithm algorithm : {BoundingPolygonAlgorithm::GiftWrapping, BoundingPolygonAlgorithm::MonotoneChain,
+													   BoundingPolygonAlgorithm::Chan, BoundingPolygonAlgorithm::QuickHull}) {
+				assert (CalculateBoundingPolygon (pointSet, algorithm) == boundingPoints);
+				assert (CalculateBoundingPolygon (PointSpan (points), algorithm) == boundingPoints);
+			}
+			assert (CalculateBoundingPolygonInParallel (pointSet, 2) == boundingPoints);
+			assert (CheckIfPolygonContainsAllPoints (boundingPoints, pointSet));
+			assert (!CheckIfPolygonContainsAllPoints (boundingPoints, PointSet {{-1,maxInt}}));
+
+			DynamicBoundingPolygon dynamicPolygon;
+			for (const Point& point : points)
+				dynamicPolygon.AddPoint (point);
+			assert (dynamicPolygon.GetPolygon () == boundingPoints);
+		}
+
+		{ // polygon contains points
+			const std::vector<Point> polygon = {{0,0}, {4,0}, {4,4}, {0,4}};
+			const PointSet points = {{0,0}, {2,0}, {2,2}, {4,3}, {1,4}};
+			assert (CheckIfPolygonContainsAllPoints (polygon, points) == true);
+		}
+
+		{ // polygon does not contain points
+			const std::vector<Point> polygon = {{0,0}, {4,0}, {4,4}, {0,4}};
+			const PointSet points = {{2,2}, {5,2}};
+			assert (CheckIfPolygonContainsAllPoints (polygon, points) == false);
+		}
+
+		{ // polygon does not contain points - point very close to a long edge
+			const std::vector<Point> polygon = {{0,0}, {1000000,1}, {0,1}};
+			const PointSet points = {{1,0}};
+			assert (CheckIfPolygonContainsAllPoints (polygon, points) == false);
+		}
+
+		{ // calculate polygon in parallel - same result as the sequential algorithms
+			PointSet points;
+			for (int i = 0; i < 5000; i++)
+				points.insert (Point ((i * 7919) % 1009 - 504, (i * 104729) % 997 - 498));
+			const std::vector<Point> boundingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (CalculateBoundingPolygonInParallel (points, 1) == boundingPoints);
+			assert (CalculateBoundingPolygonInParallel (points, 4) == boundingPoints);
+			assert (CalculateBoundingPolygonInParallel (points, 0) == boundingPoints);
+		}
+
+		{ // calculate polygon in parallel from a point array with duplicates - same result as the sequential algorithms
+			PointArray points;
+			for (int i = 0; i < 5000; i++)
+				points.push_back (Point ((i * 7919) % 101 - 50, (i * 104729) % 97 - 48));
+			const std::vector<Point> boundingPoints = CalculateBoundingPolygon (PointSpan (points), BoundingPolygonAlgorithm::MonotoneChain);
+			assert (CalculateBoundingPolygonInParallel (PointSpan (points), 1) == boundingPoints);
+			assert (CalculateBoundingPolygonInParallel (PointSpan (points), 7) == boundingPoints);
+			assert (CalculateBoundingPolygonInParallel (PointSpan (points.data (), 3), 64) == CalculateBoundingPolygon (PointSpan (points.data (), 3), BoundingPolygonAlgorithm::MonotoneChain));
+		}
+
+		{ // calculate polygon with quickhull - same result as monotone chain, sequentially and on a pool
+			PointArray points;
+			for (int i = 0; i < 100000; i++)
+				points.push_back (Point ((i * 7919) % 100003 - 50001, (i * 3001) % 99991 - 49995));
+			const std::vector<Point> boundingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::QuickHull) == boundingPoints);
+			assert (CalculateBoundingPolygonWithQuickHull (points, 1) == boundingPoints);
+			assert (CalculateBoundingPolygonWithQuickHull (points, 4) == boundingPoints);
+		}
+
+		{ // streaming polygon - same result as monotone chain for every chunk size
+			PointArray points = {{0,0}, {1,1}, {2,2}, {0,0}};
+			for (int i = 0; i < 20000; i++)
+				points.push_back (Point ((i * 7919) % 1009 - 504, (i * 3001) % 997 - 498));
+			const std::vector<Point> boundingPoints = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			for (size_t chunkSize : {1, 3, 1000, 50000}) {
+				size_t readPointCount = 0;
+				const Polygon polygon = CalculateBoundingPolygonOfStream ([&] (Point* buffer, size_t bufferSize) {
+					const size_t pointCount = std::min (bufferSize, points.size () - readPointCount);
+					std::copy (points.begin () + readPointCount, points.begin () + readPointCount + pointCount, buffer);
+					readPointCount += pointCount;
+					return pointCount;
+				}, chunkSize);
+				assert (polygon == boundingPoints);
+			}
+		}
+
+		{ // streaming polygon - points in one line are not a valid polygon
+			StreamingBoundingPolygon boundingPolygon;
+			boundingPolygon.AddPoints (PointArray ({{0,0}, {2,2}}));
+			boundingPolygon.AddPoints (PointArray ({{1,1}, {3,3}}));
+			assert (boundingPolygon.IsValidPolygon () == false);
+			boundingPolygon.AddPoints (PointArray ({{3,0}}));
+			assert (boundingPolygon.IsValidPolygon () == true);
+			assert (boundingPolygon.GetPolygon () == Polygon ({{0,0}, {3,0}, {3,3}}));
+		}
+
+		{ // point file - the mapped points and the cached polygon are the same as the written ones
+			PointArray points;
+			for (int i = 0; i < 10000; i++)
+				points.push_back (Point ((i * 7919) % 1009 - 504, (i * 3001) % 997 - 498));
+			const Polygon polygon = CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			const std::string fileName = (std::filesystem::temp_directory_path () / "ConvexPolygonTest.cvxp").string ();
+			const bool isPolygonFileWritten = Storage::WritePointFile (fileName, points, polygon);
+			assert (isPolygonFileWritten);
+
+			Storage::MappedPointFile pointFile;
+			const bool isPolygonFileOpened = pointFile.Open (fileName);
+			assert (isPolygonFileOpened);
+			assert (PointArray (pointFile.GetPoints ().begin (), pointFile.GetPoints ().end ()) == points);
+			assert (pointFile.HasPolygon ());
+			assert (Polygon (pointFile.GetPolygon ().begin (), pointFile.GetPolygon ().end ()) == polygon);
+			assert (CalculateBoundingPolygon (pointFile.GetPoints (), BoundingPolygonAlgorithm::Chan) == polygon);
+			pointFile.Close ();
+
+			const bool isFileWritten = Storage::WritePointFile (fileName, points);
+			assert (isFileWritten);
+			const bool isFileOpened = pointFile.Open (fileName);
+			assert (isFileOpened);
+			assert (pointFile.GetPoints ().size == points.size ());
+			assert (!pointFile.HasPolygon ());
+			pointFile.Close ();
+			std::filesystem::remove (fileName);
+		}
+
+		{ // point file - truncated and missing files are rejected
+			const PointArray points = {{1,1}, {4,0}, {2,3}};
+			const std::string fileName = (std::filesystem::temp_directory_path () / "ConvexPolygonTest.cvxp").string ();
+			const bool isFileWritten = Storage::WritePointFile (fileName, points);
+			assert (isFileWritten);
+			std::filesystem::resize_file (fileName, std::filesystem::file_size (fileName) - 1);
+
+			Storage::MappedPointFile pointFile;
+			const bool isTruncatedFileOpened = pointFile.Open (fileName);
+			assert (!isTruncatedFileOpened);
+			std::filesystem::remove (fileName);
+			const bool isMissingFileOpened = pointFile.Open (fileName);
+			assert (!isMissingFileOpened);
+			assert (!pointFile.IsOpen ());
+		}
+
+		{ // point file - the values are stored as little-endian bytes
+			const PointArray points = {{1,-2}, {0x01020304,3}};
+			const std::string fileName = (std::filesystem::temp_directory_path () / "ConvexPolygonTest.cvxp").string ();
+			const bool isFileWritten = Storage::WritePointFile (fileName, points);
+			assert (isFileWritten);
+
+			std::ifstream file (fileName, std::ios::binary);
+			const std::string bytes ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char> ());
+			file.close ();
+			std::filesystem::remove (fileName);
+			const std::string expectedBytes ("CVXP\x01\0\0\0\0\0\0\0\0\0\0\0\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0"
+											 "\x01\0\0\0\xfe\xff\xff\xff\x04\x03\x02\x01\x03\0\0\0", 48);
+			assert (bytes == expectedBytes);
+		}
+
+		{ // statistics of the last polygon calculation - only collected with instrumentation
+			const PointSet points = {{0,0}, {4,0}, {4,4}, {0,4}, {2,2}, {1,3}};
+			const std::vector<Point> boundingPoints = CalculateBoundingPolygon (points);
+			const BoundingPolygonStatistics statistics = GetLastBoundingPolygonStatistics ();
+#if defined (GEOMETRY_INSTRUMENTATION)
+			assert (statistics.wrapIterationCount == boundingPoints.size ());
+			assert (statistics.examinedPointCount >= boundingPoints.size () * (points.size () - boundingPoints.size ()));
+			assert (statistics.slopeComparisonCount > 0);
+			assert (statistics.verticalLineCaseCount == 2);
+			assert (statistics.searchNanoseconds > 0);
+
+			CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (GetLastBoundingPolygonStatistics ().wrapIterationCount == 0);
+			assert (GetLastBoundingPolygonStatistics ().orientationTestCount > 0);
+#else
+			assert (statistics.wrapIterationCount == 0 && statistics.searchNanoseconds == 0);
+#endif
+		}
+
+		{ // work stealing pool - nested task groups
+			Parallel::WorkStealingPool pool (3);
+			std::atomic<int> taskCount (0);
+			std::function<void (int)> runTasks = [&] (int depth) {
+				taskCount++;
+				if (depth == 0)
+					return;
+				Parallel::TaskGroup taskGroup (pool);
+				taskGroup.Run ([&, depth] { runTasks (depth - 1); });
+				taskGroup.Run ([&, depth] { runTasks (depth - 1); });
+				taskGroup.Wait ();
+			};
+			runTasks (10);
+			assert (taskCount == 2047);
+		}
+
+		{ // work stealing pool - the waiting thread wakes up when the tasks running on the workers finish
+			Parallel::WorkStealingPool pool (2);
+			std::atomic<int> taskCount (0);
+			Parallel::TaskGroup taskGroup (pool);
+			for (int i = 0; i < 4; i++) {
+				taskGroup.Run ([&taskCount] {
+					std::this_thread::sleep_for (std::chrono::milliseconds (5));
+					taskCount++;
+				});
+			}
+			std::this_thread::sleep_for (std::chrono::milliseconds (2));
+			taskGroup.Wait ();
+			assert (taskCount == 4);
+		}
+
+		{ // calculate polygon in parallel - more threads than points
+			const PointSet points = {{1,1}, {4,0}, {2,3}, {5,2}};
+			std::vector<Point> boundingPoints = CalculateBoundingPolygonInParallel (points, 64);
+			assert (boundingPoints.size () == 4);
+			assert (boundingPoints[0] == Point (1,1));
+			assert (boundingPoints[1] == Point (4,0));
+			assert (boundingPoints[2] == Point (5,2));
+			assert (boundingPoints[3] == Point (2,3));
+		}
+
+		{ // cull interior points - only the inner point is removed
+			const PointSet points = {{0,0}, {4,0}, {4,4}, {0,4}, {2,2}, {2,0}};
+			const CulledPointSet culledPoints = CullInteriorPoints (points);
+			assert (culledPoints.culledPointCount == 1);
+			assert (culledPoints.points == PointSet ({{0,0}, {4,0}, {4,4}, {0,4}, {2,0}}));
+		}
+
+		{ // cull interior points - points in a disk
+			PointSet points;
+			for (int x = -50; x <= 50; x++) {
+				for (int y = -50; y <= 50; y++) {
+					if (x * x + y * y <= 2500)
+						points.insert (Point (x,y));
+				}
+			}
+			const CulledPointSet culledPoints = CullInteriorPoints (points);
+			assert (culledPoints.culledPointCount + culledPoints.points.size () == points.size ());
+			assert (culledPoints.culledPointCount > points.size () * 3 / 4);
+			assert (CalculateBoundingPolygon (culledPoints.points, BoundingPolygonAlgorithm::MonotoneChain) ==
+					CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain));
+		}
+
+		{ // cull interior points - points in one line
+			const PointSet points = {{0,0}, {1,1}, {2,2}, {3,3}};
+			const CulledPointSet culledPoints = CullInteriorPoints (points);
+			assert (culledPoints.culledPointCount == 0);
+		}
+
+		{ // cull interior points - point array keeps the order of the remaining points
+			const PointArray points = {{2,2}, {0,0}, {4,0}, {2,0}, {1,1}, {4,4}, {0,4}, {2,2}};
+			const CulledPointArray culledPoints = CullInteriorPoints (points);
+			assert (culledPoints.culledPointCount == 3);
+			assert (culledPoints.points == PointArray ({{0,0}, {4,0}, {2,0}, {4,4}, {0,4}}));
+		}
+
+		{ // cull interior points - point array in a disk
+			PointArray points;
+			for (int x = -50; x <= 50; x++) {
+				for (int y = -50; y <= 50; y++) {
+					if (x * x + y * y <= 2500)
+						points.push_back (Point (x,y));
+				}
+			}
+			const CulledPointArray culledPoints = CullInteriorPoints (points);
+			assert (culledPoints.culledPointCount + culledPoints.points.size () == points.size ());
+			assert (culledPoints.culledPointCount > points.size () * 3 / 4);
+			assert (CalculateBoundingPolygon (culledPoints.points, BoundingPolygonAlgorithm::QuickHull) ==
+					CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::QuickHull));
+		}
+
+		{ // dynamic polygon - points added and removed
+			DynamicBoundingPolygon boundingPolygon;
+			boundingPolygon.AddPoint (Point (0,0));
+			boundingPolygon.AddPoint (Point (4,0));
+			boundingPolygon.AddPoint (Point (4,4));
+			assert (boundingPolygon.AddPoint (Point (0,4)) == true);
+			assert (boundingPolygon.AddPoint (Point (2,2)) == false);
+			assert (boundingPolygon.GetPointCount () == 5);
+			assert (boundingPolygon.GetPolygon () == Polygon ({{0,0}, {4,0}, {4,4}, {0,4}}));
+			assert (boundingPolygon.RemovePoint (Point (2,2)) == false);
+			assert (boundingPolygon.RemovePoint (Point (4,4)) == true);
+			assert (boundingPolygon.GetPolygon () == Polygon ({{0,0}, {4,0}, {0,4}}));
+			assert (boundingPolygon.RemovePoint (Point (4,4)) == false);
+			assert (boundingPolygon.GetPointCount () == 3);
+		}
+
+		{ // dynamic polygon - removing a corner brings back inner points
+			DynamicBoundingPolygon boundingPolygon;
+			const PointSet points = {{0,0}, {6,0}, {3,6}, {2,1}, {4,1}, {3,3}};
+			for (const Point& point : points)
+				boundingPolygon.AddPoint (point);
+			assert (boundingPolygon.GetPolygon () == Polygon ({{0,0}, {6,0}, {3,6}}));
+			assert (boundingPolygon.RemovePoint (Point (3,6)) == true);
+			assert (boundingPolygon.GetPolygon () == Polygon ({{0,0}, {6,0}, {3,3}}));
+			assert (boundingPolygon.RemovePoint (Point (0,0)) == true);
+			assert (boundingPolygon.GetPolygon () == Polygon ({{2,1}, {6,0}, {3,3}}));
+		}
+
+		{ // dynamic polygon - the snapshot is not affected by later changes
+			DynamicBoundingPolygon boundingPolygon;
+			assert (boundingPolygon.GetSnapshot ().IsValidPolygon () == false);
+			boundingPolygon.AddPoint (Point (0,0));
+			boundingPolygon.AddPoint (Point (4,0));
+			boundingPolygon.AddPoint (Point (0,4));
+			const BoundingPolygonSnapshot snapshot = boundingPolygon.GetSnapshot ();
+			boundingPolygon.AddPoint (Point (4,4));
+			boundingPolygon.RemovePoint (Point (0,0));
+			assert (snapshot.IsValidPolygon ());
+			assert (snapshot.GetPolygon () == Polygon ({{0,0}, {4,0}, {0,4}}));
+			assert (boundingPolygon.GetSnapshot ().GetPolygon () == boundingPolygon.GetPolygon ());
+			boundingPolygon.Clear ();
+			assert (snapshot.GetPolygon () == Polygon ({{0,0}, {4,0}, {0,4}}));
+		}
+
+		{ // dynamic polygon - same result as monotone chain
+			DynamicBoundingPolygon boundingPolygon;
+			PointSet points;
+			for (int i = 0; i < 300; i++) {
+				const Point point ((i * 37) % 101 - 50, (i * 53) % 97 - 48);
+				points.insert (point);
+				boundingPolygon.AddPoint (point);
+			}
+			for (int i = 0; i < 300; i += 3) {
+				const Point point ((i * 37) % 101 - 50, (i * 53) % 97 - 48);
+				points.erase (point);
+				boundingPolygon.RemovePoint (point);
+			}
+			assert (boundingPolygon.GetPointCount () == points.size ());
+			assert (boundingPolygon.GetPolygon () == CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain));
+		}
+
+		{ // dynamic polygon - collinear points and vertical lines on a small grid
+			DynamicBoundingPolygon boundingPolygon;
+			PointSet points;
+			for (int i = 0; i < 400; i++) {
+				const Point point ((i * 7) % 6, (i * 11) % 5);
+				if (i % 3 == 2 && points.erase (point) > 0) {
+					boundingPolygon.RemovePoint (point);
+				} else {
+					points.insert (point);
+					boundingPolygon.AddPoint (point);
+				}
+				if (points.size () > 2 && !AreAllPointsInOneLine (points))
+					assert (boundingPolygon.GetPolygon () == CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain));
+			}
+		}
+
+		{ // dynamic polygon - extremes and bounds after adding and removing points
+			DynamicBoundingPolygon boundingPolygon;
+			for (const Point& point : {Point (0,0), Point (4,-2), Point (6,1), Point (3,5), Point (2,2), Point (6,3), Point (0,4)})
+				boundingPolygon.AddPoint (point);
+			assert (boundingPolygon.GetLeftMostPoint () == Point (0,0));
+			assert (boundingPolygon.GetRightMostPoint () == Point (6,3));
+			PointBounds bounds = boundingPolygon.GetPointBounds ();
+			assert (bounds.minXCoord == 0 && bounds.maxXCoord == 6 && bounds.minYCoord == -2 && bounds.maxYCoord == 5);
+			boundingPolygon.RemovePoint (Point (4,-2));
+			boundingPolygon.RemovePoint (Point (0,0));
+			boundingPolygon.RemovePoint (Point (3,5));
+			assert (boundingPolygon.GetLeftMostPoint () == Point (0,4));
+			bounds = boundingPolygon.GetPointBounds ();
+			assert (bounds.minXCoord == 0 && bounds.maxXCoord == 6 && bounds.minYCoord == 1 && bounds.maxYCoord == 4);
+		}
+
+		{ // dynamic polygon - extremes and bounds are the same as the ones of the point set
+			DynamicBoundingPolygon boundingPolygon;
+			PointSet points;
+			for (int i = 0; i < 400; i++) {
+				const Point point ((i * 7) % 6, (i * 11) % 5);
+				if (i % 3 == 2 && points.erase (point) > 0) {
+					boundingPolygon.RemovePoint (point);
+				} else {
+					points.insert (point);
+					boundingPolygon.AddPoint (point);
+				}
+				if (points.empty ())
+					continue;
+				const PointBounds bounds = boundingPolygon.GetPointBounds ();
+				const PointBounds expectedBounds = CalculatePointBounds (points);
+				assert (bounds.minXCoord == expectedBounds.minXCoord && bounds.maxXCoord == expectedBounds.maxXCoord);
+				assert (bounds.minYCoord == expectedBounds.minYCoord && bounds.maxYCoord == expectedBounds.maxYCoord);
+				assert (boundingPolygon.GetLeftMostPoint () == FindLeftMostPoint (points));
+				assert (boundingPolygon.GetRightMostPoint () == *std::max_element (points.begin (), points.end (), PointComparator ()));
+			}
+		}
+
+		{ // point source - same result as the point set for all algorithms
+			PointSet points;
+			for (int i = 0; i < 3000; i++)
+				points.insert (Point ((i * 37) % 211 - 100, (i * 53) % 197 - 98));
+			const auto mirror = [] (const Point& point) { return Point (point.x, -point.y); };
+			PointSet mirroredPoints;
+			for (const Point& point : points)
+				mirroredPoints.insert (mirror (point));
+			const ConvertedPointSource<PointSet, decltype (mirror)> pointSource (points, mirror);
+			assert (pointSource.GetPointCount () == points.size ());
+			assert (FindLeftMostPoint (pointSource) == FindLeftMostPoint (mirroredPoints));
+			assert (AreAllPointsInOneLine (pointSource) == false);
+			const std::vector<Point> boundingPoints = CalculateBoundingPolygon (mirroredPoints, BoundingPolygonAlgorithm::MonotoneChain);
+			assert (CalculateBoundingPolygon (pointSource, BoundingPolygonAlgorithm::GiftWrapping) == boundingPoints);
+			assert (CalculateBoundingPolygon (pointSource, BoundingPolygonAlgorithm::MonotoneChain) == boundingPoints);
+			assert (CalculateBoundingPolygon (pointSource, BoundingPolygonAlgorithm::Chan) == boundingPoints);
+			assert (CalculateBoundingPolygon (pointSource, BoundingPolygonAlgorithm::QuickHull) == boundingPoints);
+			assert (CheckIfPolygonContainsAllPoints (boundingPoints, pointSource));
+		}
+
+		{ // gift wrapping - collinear points on every side
+			for (int size = 1; size < 6; size++) {
+				PointSet points;
+				for (int x = 0; x <= size; x++) {
+					points.insert (Point (x, 0));
+					points.insert (Point (x, size));
+					points.insert (Point (0, x));
+					points.insert (Point (size, x));
+					points.insert (Point (x, x));
+				}
+				assert (CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::GiftWrapping) ==
+						CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::MonotoneChain));
+			}
+		}
+
 		{ // large amount of points
 			PointSet points;
 			const int lowerBound = 0;
@@ -242,6 +822,12 @@ namespace Test
 			auto duration = std::chrono::duration_cast<std::chrono::seconds>(stop - start);
 			assert (duration.count () < 10);
 
+			start = std::chrono::high_resolution_clock::now ();
+			assert (CalculateBoundingPolygon (points, BoundingPolygonAlgorithm::Chan) == boundingPoints);
+			stop = std::chrono::high_resolution_clock::now ();
+			duration = std::chrono::duration_cast<std::chrono::seconds>(stop - start);
+			assert (duration.count () < 10);
+
 			assert (boundingPoints.size () == 4);
 			assert (boundingPoints[0] == Point (lowerBound, lowerBound));
 			assert (boundingPoints[1] == Point (upperBound, lowerBound));
@@ -0,0 +1,177 @@
+#include "WorkStealingPool.hpp"
+
+namespace Parallel
+{
+    // the pool and the queue of the worker running on the current thread
+    static thread_local const WorkStealingPool* currentPool = nullptr;
+    static thread_local size_t currentQueueIndex = 0;
+
+
+    // the last queue belongs to the threads outside of the pool
+    WorkStealingPool::WorkStealingPool (unsigned int workerCount) :
+        queuedTaskCount (0),
+        stopRequested (false)
+    {
+        for (unsigned int queueIndex = 0; queueIndex <= workerCount; queueIndex++)
+            queues.push_back (std::make_unique<TaskQueue> ());
+        for (unsigned int queueIndex = 0; queueIndex < workerCount; queueIndex++)
+            workers.emplace_back (&WorkStealingPool::RunWorker, this, queueIndex);
+    }
+
+
+    // the workers finish the queued tasks before they stop
+    WorkStealingPool::~WorkStealingPool ()
+    {
+        {
+            std::lock_guard<std::mutex> lock (sleepMutex);
+            stopRequested = true;
+        }
+        taskAvailable.notify_all ();
+        for (std::thread& worker : workers)
+            worker.join ();
+    }
+
+
+    unsigned int WorkStealingPool::GetWorkerCount () const
+    {
+        return (unsigned int) workers.size ();
+    }
+
+
+    void WorkStealingPool::Submit (Task task)
+    {
+        TaskQueue& queue = *queues[GetCurrentQueueIndex ()];
+        {
+            std::lock_guard<std::mutex> lock (queue.mutex);
+            queue.tasks.push_back (std::move (task));
+        }
+        queuedTaskCount++;
+
+        // a worker checks queuedTaskCount while holding sleepMutex, so it either sees the new task or gets the notification
+        {
+            std::lock_guard<std::mutex> lock (sleepMutex);
+        }
+        taskAvailable.notify_one ();
+    }
+
+
+    // runs one task of the own queue, or one stolen from another queue
+    // returns false if there was no task to run
+    bool WorkStealingPool::RunPendingTask ()
+    {
+        const size_t queueIndex = GetCurrentQueueIndex ();
+        Task task;
+        if (!PopTask (queueIndex, task) && !StealTask (queueIndex, task))
+            return false;
+
+        queuedTaskCount--;
+        task ();
+        return true;
+    }
+
+
+    // blocks until a task is queued or isWaitFinished returns true
+    // the condition is checked while holding sleepMutex, so a change followed by NotifyWaitingThreads is never missed
+    void WorkStealingPool::WaitForTask (const std::function<bool ()>& isWaitFinished)
+    {
+        std::unique_lock<std::mutex> lock (sleepMutex);
+        taskAvailable.wait (lock, [this, &isWaitFinished] { return queuedTaskCount > 0 || isWaitFinished (); });
+    }
+
+
+    void WorkStealingPool::NotifyWaitingThreads ()
+    {
+        {
+            std::lock_guard<std::mutex> lock (sleepMutex);
+        }
+        taskAvailable.notify_all ();
+    }
+
+
+    size_t WorkStealingPool::GetCurrentQueueIndex () const
+    {
+        return currentPool == this ? currentQueueIndex : queues.size () - 1;
+    }
+
+
+    bool WorkStealingPool::PopTask (size_t queueIndex, Task& task)
+    {
+        TaskQueue& queue = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock (queue.mutex);
+        if (queue.tasks.empty ())
+            return false;
+
+        task = std::move (queue.tasks.back ());
+        queue.tasks.pop_back ();
+        return true;
+    }
+
+
+    // the oldest tasks are stolen, they are usually the biggest ones
+    bool WorkStealingPool::StealTask (size_t thiefQueueIndex, Task& task)
+    {
+        for (size_t offset = 1; offset < queues.size (); offset++) {
+            TaskQueue& queue = *queues[(thiefQueueIndex + offset) % queues.size ()];
+            std::lock_guard<std::mutex> lock (queue.mutex);
+            if (queue.tasks.empty ())
+                continue;
+
+            task = std::move (queue.tasks.front ());
+            queue.tasks.pop_front ();
+            return true;
+        }
+        return false;
+    }
+
+
+    void WorkStealingPool::RunWorker (size_t queueIndex)
+    {
+        currentPool = this;
+        currentQueueIndex = queueIndex;
+
+        while (true) {
+            if (RunPendingTask ())
+                continue;
+
+            std::unique_lock<std::mutex> lock (sleepMutex);
+            taskAvailable.wait (lock, [this] { return stopRequested || queuedTaskCount > 0; });
+            if (stopRequested && queuedTaskCount == 0)
+                return;
+        }
+    }
+
+
+    TaskGroup::TaskGroup (WorkStealingPool& pool) :
+        pool (pool),
+        pendingTaskCount (0)
+    {
+    }
+
+
+    // the tasks may refer to the state of the creator of the group, so they have to finish before it is destroyed
+    TaskGroup::~TaskGroup ()
+    {
+        Wait ();
+    }
+
+
+    // the group may be destroyed as soon as the last task is finished, so only the pool is used after that
+    void TaskGroup::Run (Task task)
+    {
+        pendingTaskCount++;
+        pool.Submit ([this, &groupPool = pool, task = std::move (task)] {
+            task ();
+            if (--pendingTaskCount == 0)
+                groupPool.NotifyWaitingThreads ();
+        });
+    }
+
+
+    void TaskGroup::Wait ()
+    {
+        while (pendingTaskCount > 0) {
+            if (!pool.RunPendingTask ())
+                pool.WaitForTask ([this] { return pendingTaskCount == 0; });
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Parallel
+{
+    typedef std::function<void ()> Task;
+
+
+    // every worker thread has its own task queue, the threads outside of the pool share one more queue
+    // a thread pushes and pops the tasks at the back of its own queue, and steals from the front of the other queues if its queue is empty
+    class WorkStealingPool
+    {
+    public:
+        explicit WorkStealingPool (unsigned int workerCount);
+        ~WorkStealingPool ();
+
+        WorkStealingPool (const WorkStealingPool&) = delete;
+        WorkStealingPool& operator= (const WorkStealingPool&) = delete;
+
+        unsigned int GetWorkerCount () const;
+        void Submit (Task task);
+        bool RunPendingTask ();
+        void WaitForTask (const std::function<bool ()>& isWaitFinished);
+        void NotifyWaitingThreads ();
+
+    private:
+        struct TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        size_t GetCurrentQueueIndex () const;
+        bool PopTask (size_t queueIndex, Task& task);
+        bool StealTask (size_t thiefQueueIndex, Task& task);
+        void RunWorker (size_t queueIndex);
+
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+        std::vector<std::thread> workers;
+        std::atomic<size_t> queuedTaskCount;
+        std::mutex sleepMutex;
+        std::condition_variable taskAvailable;
+        bool stopRequested;
+    };
+
+
+    // the tasks started in a group can be waited for together
+    // the waiting thread runs the pending tasks of the pool in the meantime, so nested groups do not block the workers
+    // if there is nothing to run, it sleeps until a new task is submitted or the last task of the group finishes
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup (WorkStealingPool& pool);
+        ~TaskGroup ();
+
+        TaskGroup (const TaskGroup&) = delete;
+        TaskGroup& operator= (const TaskGroup&) = delete;
+
+        void Run (Task task);
+        void Wait ();
+
+    private:
+        WorkStealingPool& pool;
+        std::atomic<size_t> pendingTaskCount;
+    };
+}
+
+
+#endif
\ No newline at end of file